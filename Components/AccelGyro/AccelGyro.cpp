@@ -5,16 +5,26 @@
 // ======================================================================
 
 #include "Components/AccelGyro/AccelGyro.hpp"
+#include "Components/AccelGyro/ActiveAccelGyroComponentAc.hpp"
+#include "Fw/Com/ComPacket.hpp"
+
+#include <cstring>
 
 namespace Components {
 
+  // out of line definitions for the scale tables, they are indexed at runtime
+  template <class Base>
+  constexpr float AccelGyroCore<Base>::accelScaleFactors[];
+  template <class Base>
+  constexpr float AccelGyroCore<Base>::gyroScaleFactors[];
+
   // ----------------------------------------------------------------------
   // Component construction and destruction
   // ----------------------------------------------------------------------
 
   AccelGyro ::
     AccelGyro(const char* const compName) :
-      AccelGyroComponentBase(compName)
+      AccelGyroCore<AccelGyroComponentBase>(compName)
   {
 
   }
@@ -25,16 +35,59 @@ namespace Components {
     AccelGyroComponentBase::init(instance);
   }
 
+  AccelGyro ::
+    ~AccelGyro()
+  {
+
+  }
+
   void AccelGyro ::
+    parameterUpdated(FwPrmIdType id)
+  {
+    // take the guard so the new settings land between ticks
+    const U32 groups = configGroups(id);
+    if (groups != 0) {
+      this->lock();
+      applyConfig(groups);
+      this->unLock();
+    }
+  }
+
+  template <class Base>
+  AccelGyroCore<Base> ::
+    AccelGyroCore(const char* const compName) :
+      Base(compName)
+  {
+    this->m_shadow.track(SMPLRT_DIV_ADDR);
+    this->m_shadow.track(DEVICE_CONFIG_ADDR);
+    this->m_shadow.track(GYRO_CONFIG_ADDR);
+    this->m_shadow.track(ACCEL_CONFIG_ADDR);
+    this->m_shadow.track(FIFO_EN_ADDR);
+    this->m_shadow.track(INT_PIN_CFG_ADDR);
+    this->m_shadow.track(INT_ENABLE_ADDR);
+    this->m_shadow.track(POWER_MGMT_ADDR);
+    this->m_sampleClock.configure(GYRO_PERIOD_US_DLPF_ON);
+  }
+
+  template <class Base>
+  AccelGyroCore<Base> ::
+    ~AccelGyroCore()
+  {
+
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
     setup(I2cAddr::T devAddress)
   {
     m_I2cDevAddress = devAddress;
   }
 
-  AccelGyro ::
-    ~AccelGyro()
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    setSampleRing(ImuSampleRing* ring)
   {
-
+    this->m_ring = ring;
   }
 
 
@@ -42,173 +95,1081 @@ namespace Components {
   // Handler implementations for typed input ports
   // ----------------------------------------------------------------------
 
-  void AccelGyro ::
+  template <class Base>
+  void AccelGyroCore<Base> ::
     Run_handler(
         FwIndexType portNum,
         U32 context
     )
   {
-    if (this->m_power == Fw::On::ON) {
-      updateAccel();
-      updateGyro();
+    if (this->m_power != Fw::On::ON) {
+      return;
+    }
+
+    // in DATA_READY mode the edges drive acquisition and the tick has nothing to read, it only counts a backoff down
+    // so the backoff lasts the same ticks in every mode
+    if (this->m_mode != AcquisitionMode::DATA_READY) {
+      acquire(0);
+    }
+    else if (this->m_backoffTicks > 0) {
+      this->m_backoffTicks--;
     }
-    // TODO
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    jobDone_handler(
+        FwIndexType portNum,
+        U32 context,
+        const Drv::I2cStatus& status,
+        const Fw::Buffer& readBuffer
+    )
+  {
+    this->m_jobPending = false;
+
+    // a read that completes after power off is stale
+    if (this->m_power != Fw::On::ON) {
+      return;
+    }
+    this->m_profiler.mark(STAGE_BUS);
+
+    switch (context) {
+      case JOB_SAMPLE:
+        publishSample(status, readBuffer, this->m_jobEdgeUs);
+        break;
+      case JOB_FIFO_COUNT: {
+        const U32 frames = fifoFramesQueued(status, readBuffer);
+        if (frames > 0) {
+          // FIFO_R_W does not auto-increment so every queued frame comes out of one block read
+          this->m_jobFrames = frames;
+          submitJob(JOB_FIFO_DATA, FIFO_R_W_ADDR, this->m_fifoData, frames * FIFO_FRAME_SIZE);
+        }
+        break;
+      }
+      case JOB_FIFO_DATA:
+        publishFrames(status, readBuffer, this->m_jobFrames);
+        break;
+      default:
+        FW_ASSERT(0, context);
+        break;
+    }
+
+    // the tick ends with the last job it queues
+    if (!this->m_jobPending) {
+      this->m_profiler.finish();
+    }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    latencyRun_handler(
+        FwIndexType portNum,
+        U32 context
+    )
+  {
+    if (!TickProfiler::ENABLED) {
+      return;
+    }
+    this->tlmWrite_busLatency(stageLatency(STAGE_BUS));
+    this->tlmWrite_decodeLatency(stageLatency(STAGE_DECODE));
+    this->tlmWrite_publishLatency(stageLatency(STAGE_PUBLISH));
+    this->tlmWrite_tickLatency(stageLatency(STAGE_TICK));
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    dataReady_handler(
+        FwIndexType portNum,
+        U64 timeUs
+    )
+  {
+    // an edge left over from before a mode change or power off is ignored
+    if ((this->m_power == Fw::On::ON) && (this->m_mode == AcquisitionMode::DATA_READY)) {
+      acquire(timeUs);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Parameter update hook
+  // ----------------------------------------------------------------------
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    parametersLoaded()
+  {
+    configDecimator();
+    configDeadbands();
+    configTlmFormat();
   }
 
   // ----------------------------------------------------------------------
   // Handler implementations for commands
   // ----------------------------------------------------------------------
 
-  void AccelGyro ::
+  template <class Base>
+  void AccelGyroCore<Base> ::
     POWER_ON_OFF_cmdHandler(
         FwOpcodeType opCode,
         U32 cmdSeq,
         Fw::On powerState
     )
   {
-    // TODO
-    power(powerState);
+    // a failed power write has already logged PowerModeError and left the power state as it was
+    if (!power(powerState)) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::EXECUTION_ERROR);
+      return;
+    }
     this->log_ACTIVITY_HI_PowerState(powerState);
     this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
   }
 
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    SET_ACQUISITION_MODE_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq,
+        Components::AcquisitionMode mode
+    )
+  {
+    this->m_mode = mode;
+
+    // a powered device is switched over immediately, otherwise config() applies it on power on
+    if (this->m_power == Fw::On::ON) {
+      stageInterrupts();
+      flushConfig();
+      configFifo();
+    }
+    this->log_ACTIVITY_HI_AcquisitionModeSet(mode);
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    RESET_LATENCY_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    // a tick in flight with the bus manager is dropped rather than half counted
+    this->m_profiler.reset();
+    this->log_ACTIVITY_HI_LatencyReset();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    RESET_ERROR_THROTTLE_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    // the counters keep counting while the events are throttled, only the events start again
+    this->log_WARNING_HI_TelemetryError_ThrottleClear();
+    this->log_WARNING_LO_BusBackoff_ThrottleClear();
+    this->log_ACTIVITY_HI_ErrorThrottleReset();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
   // ----------------------------------------------------------------------
   // Helper Functions
   // ----------------------------------------------------------------------
 
-  Drv::I2cStatus AccelGyro ::
-    setupReadRegister(U8 registerAddress)
+  template <class Base>
+  U32 AccelGyroCore<Base> ::
+    configGroups(FwPrmIdType id)
   {
-    Fw::Buffer buffer(&registerAddress, sizeof registerAddress);
-    return this->write_out(0, this->m_I2cDevAddress, buffer);
+    switch (id) {
+      case Base::PARAMID_SAMPLE_RATE_DIVIDER:
+      case Base::PARAMID_DLPF_BANDWIDTH:
+        return CONFIG_SAMPLE_RATE;
+      case Base::PARAMID_ACCEL_RANGE:
+      case Base::PARAMID_GYRO_RANGE:
+        return CONFIG_RANGES;
+      case Base::PARAMID_DECIMATION_FILTER:
+      case Base::PARAMID_DECIMATION_RATIO:
+      case Base::PARAMID_FIR_TAPS:
+        return CONFIG_DECIMATOR;
+      case Base::PARAMID_ACCEL_DEADBAND:
+      case Base::PARAMID_GYRO_DEADBAND:
+      case Base::PARAMID_TLM_HEARTBEAT:
+        return CONFIG_DEADBANDS;
+      case Base::PARAMID_ACCEL_TLM_FORMAT:
+      case Base::PARAMID_GYRO_TLM_FORMAT:
+        return CONFIG_TLM_FORMAT;
+      default:
+        return 0;
+    }
   }
 
-  Drv::I2cStatus AccelGyro ::
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    applyConfig(U32 groups)
+  {
+    // device settings only go to a powered device, an unpowered one picks them up in config()
+    if (this->m_power == Fw::On::ON) {
+      if ((groups & CONFIG_SAMPLE_RATE) != 0) {
+        configSampleRate();
+      }
+      // range and scale factor change together so no tick decodes with a mismatched pair
+      if ((groups & CONFIG_RANGES) != 0) {
+        configRanges();
+      }
+    }
+
+    // the filter, deadbands and format are software only, swap them whatever the power state
+    if ((groups & CONFIG_DECIMATOR) != 0) {
+      configDecimator();
+    }
+    if ((groups & CONFIG_DEADBANDS) != 0) {
+      configDeadbands();
+    }
+    if ((groups & CONFIG_TLM_FORMAT) != 0) {
+      configTlmFormat();
+    }
+  }
+
+  template <class Base>
+  Drv::I2cStatus AccelGyroCore<Base> ::
     readRegisterBlock(U8 startRegisterAddress, Fw::Buffer& buffer)
   {
-    Drv::I2cStatus status;
-    status = setupReadRegister(startRegisterAddress);
+    // the pointer write and the block read share one transaction, so nothing can move the pointer in between
+    Fw::Buffer pointerBuffer(&startRegisterAddress, sizeof startRegisterAddress);
+    return this->writeRead_out(0, this->m_I2cDevAddress, pointerBuffer, buffer);
+  }
 
-    if (status == Drv::I2cStatus::I2C_OK) {
-      status = this->read_out(0, m_I2cDevAddress, buffer);
+  template <class Base>
+  Drv::I2cStatus AccelGyroCore<Base> ::
+    writeRegister(U8 registerAddress, U8 value)
+  {
+    if (this->m_shadow.tracked(registerAddress)) {
+      this->m_shadow.stage(registerAddress, value);
+      return flushRegisters();
     }
 
+    U8 data[REG_SIZE_BYTES * 2];
+    Fw::Buffer buffer(data, sizeof data);
+
+    data[0] = registerAddress;
+    data[1] = value;
+    const Drv::I2cStatus status = this->write_out(0, this->m_I2cDevAddress, buffer);
+    if (status != Drv::I2cStatus::I2C_OK) {
+      writeFailed();
+    }
     return status;
   }
 
-  F32x3 AccelGyro ::
-    deserializeVector(Fw::Buffer& buffer, F32 scaleFactor)
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    writeFailed()
   {
-    Components::F32x3 vect;
-    I16 value;
-    FW_ASSERT(buffer.getSize() == 6);
-    FW_ASSERT(buffer.getData() != nullptr);
+    this->m_writeErrors++;
+    this->tlmWrite_writeErrors(this->m_writeErrors);
+  }
 
-    Fw::SerializeBufferBase& deserializeHelper = buffer.getSerializeRepr();
-    deserializeHelper.setBuffLen(buffer.getSize());
-    FW_ASSERT(deserializeHelper.deserialize(value) == Fw::FW_SERIALIZE_OK);
-    vect[0] = static_cast<F32>(value) / scaleFactor;
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    readFailed(Drv::I2cStatus status)
+  {
+    this->m_readErrors++;
+    this->m_consecutiveFailures++;
+    this->tlmWrite_readErrors(this->m_readErrors);
+    this->tlmWrite_consecutiveFailures(this->m_consecutiveFailures);
+    this->log_WARNING_HI_TelemetryError(status, this->m_consecutiveFailures);
 
-    FW_ASSERT(deserializeHelper.deserialize(value) == Fw::FW_SERIALIZE_OK);
-    vect[1] = static_cast<F32>(value) / scaleFactor;
+    Fw::ParamValid valid;
+    const U8 threshold = this->paramGet_BACKOFF_THRESHOLD(valid);
+    const U16 maxTicks = this->paramGet_MAX_BACKOFF_TICKS(valid);
+    if ((threshold == 0) || (this->m_consecutiveFailures < threshold) || (maxTicks == 0)) {
+      return;
+    }
 
-    FW_ASSERT(deserializeHelper.deserialize(value) == Fw::FW_SERIALIZE_OK);
-    vect[2] = static_cast<F32>(value) / scaleFactor;
+    // the gap doubles with every failure past the threshold, a U16 cap means no shift past 15 is needed
+    const U32 doublings = this->m_consecutiveFailures - threshold;
+    const U32 ticks = (doublings < 16) ? (1u << doublings) : 0xFFFFu;
+    this->m_backoffTicks = static_cast<U16>((ticks < maxTicks) ? ticks : maxTicks);
+    this->log_WARNING_LO_BusBackoff(this->m_consecutiveFailures, this->m_backoffTicks);
+  }
 
-    return vect;
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    readSucceeded()
+  {
+    if (this->m_consecutiveFailures == 0) {
+      return;
+    }
+    this->log_ACTIVITY_HI_BusRecovered(this->m_consecutiveFailures);
+    this->m_consecutiveFailures = 0;
+    this->m_backoffTicks = 0;
+    this->tlmWrite_consecutiveFailures(0);
   }
 
-  void AccelGyro ::
+  template <class Base>
+  F32x3 AccelGyroCore<Base> ::
+    deserializeVector(const U8* data, F32 scaleFactor)
+  {
+    FW_ASSERT(data != nullptr);
+
+    return F32x3(SampleDecode::scaleAxis(&data[0], scaleFactor),
+                 SampleDecode::scaleAxis(&data[2], scaleFactor),
+                 SampleDecode::scaleAxis(&data[4], scaleFactor));
+  }
+
+  template <class Base>
+  I16x3 AccelGyroCore<Base> ::
+    countsVector(const U8* data)
+  {
+    FW_ASSERT(data != nullptr);
+
+    return I16x3(SampleDecode::rawAxis(&data[0]), SampleDecode::rawAxis(&data[2]), SampleDecode::rawAxis(&data[4]));
+  }
+
+  template <class Base>
+  StageLatency AccelGyroCore<Base> ::
+    stageLatency(Stage stage) const
+  {
+    LatencyBuckets buckets;
+    const U32* const counts = this->m_profiler.buckets(stage);
+    FW_ASSERT(counts != nullptr);
+    for (FwSizeType b = 0; b < TickProfiler::NUM_BUCKETS; b++) {
+      buckets[b] = counts[b];
+    }
+    return StageLatency(this->m_profiler.count(stage), this->m_profiler.p99Ns(stage), this->m_profiler.maxNs(stage),
+                        buckets);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
     config()
   {
-    U8 data[REG_SIZE_BYTES * 2];
-    Fw::Buffer buffer(data, sizeof data);
+    // SMPLRT_DIV, CONFIG, GYRO_CONFIG and ACCEL_CONFIG are consecutive and go out together
+    stageSampleRate();
+    stageRanges();
+    stageInterrupts();
+    flushConfig();
+    sampleRateApplied();
+    rangesApplied();
+  }
 
-    data[0] = ACCEL_CONFIG_ADDR;
-    data[1] = 0;      // sets the accel sensitivity to +-2g
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configSampleRate()
+  {
+    stageSampleRate();
+    flushConfig();
+    sampleRateApplied();
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configRanges()
+  {
+    stageRanges();
+    flushConfig();
+    rangesApplied();
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    stageSampleRate()
+  {
+    Fw::ParamValid valid;
+    const U8 divider = this->paramGet_SAMPLE_RATE_DIVIDER(valid);
+    const DlpfBandwidth bandwidth = this->paramGet_DLPF_BANDWIDTH(valid);
+
+    // DLPF_CFG is the low three bits of CONFIG, FSYNC is left disabled
+    this->m_shadow.stage(SMPLRT_DIV_ADDR, divider);
+    this->m_shadow.stage(DEVICE_CONFIG_ADDR, static_cast<U8>(bandwidth.e));
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    stageRanges()
+  {
+    Fw::ParamValid valid;
+    const AccelRange accelRange = this->paramGet_ACCEL_RANGE(valid);
+    const GyroRange gyroRange = this->paramGet_GYRO_RANGE(valid);
+    FW_ASSERT(accelRange.isValid(), accelRange.e);
+    FW_ASSERT(gyroRange.isValid(), gyroRange.e);
+
+    this->m_shadow.stage(GYRO_CONFIG_ADDR, static_cast<U8>(gyroRange.e << FULL_SCALE_SHIFT));
+    this->m_shadow.stage(ACCEL_CONFIG_ADDR, static_cast<U8>(accelRange.e << FULL_SCALE_SHIFT));
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    stageInterrupts()
+  {
+    // INT_PIN_CFG and INT_ENABLE are adjacent and go out in one burst
+    const bool dataReady = (this->m_mode == AcquisitionMode::DATA_READY);
+    this->m_shadow.stage(INT_PIN_CFG_ADDR, dataReady ? INT_PIN_CFG_DATA_RDY : INT_PIN_CFG_DEFAULT);
+    this->m_shadow.stage(INT_ENABLE_ADDR, dataReady ? INT_ENABLE_DATA_RDY : INT_ENABLE_NONE);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    sampleRateApplied()
+  {
+    U8 divider = 0;
+    U8 dlpf = 0;
+    if (!this->m_shadow.known(SMPLRT_DIV_ADDR, divider) || !this->m_shadow.known(DEVICE_CONFIG_ADDR, dlpf)) {
+      return;
+    }
+    const U32 gyroPeriodUs = (dlpf == DlpfBandwidth::BW_260HZ) ? GYRO_PERIOD_US_DLPF_OFF : GYRO_PERIOD_US_DLPF_ON;
+    this->m_sampleClock.configure(gyroPeriodUs * (static_cast<U32>(divider) + 1));
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    rangesApplied()
+  {
+    // the scale factor only follows the range once the device holds it
+    // raw telemetry is only meaningful alongside the range it was read at, so the range goes down when it changes
+    const U8 rangeMask = NUM_FULL_SCALE_RANGES - 1;
+    U8 value = 0;
+    if (this->m_shadow.known(ACCEL_CONFIG_ADDR, value)) {
+      const AccelRange accelRange(static_cast<AccelRange::T>((value >> FULL_SCALE_SHIFT) & rangeMask));
+      this->m_accelScale = accelScaleFactors[accelRange.e];
+      this->tlmWrite_accelRange(accelRange);
+    }
+    if (this->m_shadow.known(GYRO_CONFIG_ADDR, value)) {
+      const GyroRange gyroRange(static_cast<GyroRange::T>((value >> FULL_SCALE_SHIFT) & rangeMask));
+      this->m_gyroScale = gyroScaleFactors[gyroRange.e];
+      this->tlmWrite_gyroRange(gyroRange);
+    }
+
+    // filter history is in raw counts of the old range
+    this->m_decimator.reset();
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    flushConfig()
+  {
+    const Drv::I2cStatus status = flushRegisters();
+    if (status != Drv::I2cStatus::I2C_OK) {
+      this->log_WARNING_HI_ConfigError(status);
+    }
+  }
+
+  template <class Base>
+  Drv::I2cStatus AccelGyroCore<Base> ::
+    flushRegisters()
+  {
+    // register pointer first, the device auto-increments through the rest of the run
+    U8 data[ConfigShadow::SPAN + 1];
+    Drv::I2cStatus result = Drv::I2cStatus::I2C_OK;
+    FwSizeType count = this->m_shadow.nextRun(data[0], &data[1]);
+    while (count > 0) {
+      Fw::Buffer buffer(data, static_cast<U32>(count + 1));
+      const Drv::I2cStatus status = this->write_out(0, this->m_I2cDevAddress, buffer);
+      this->m_shadow.written(data[0], count, status == Drv::I2cStatus::I2C_OK);
+      if (status != Drv::I2cStatus::I2C_OK) {
+        writeFailed();
+        if (result == Drv::I2cStatus::I2C_OK) {
+          result = status;
+        }
+      }
+      count = this->m_shadow.nextRun(data[0], &data[1]);
+    }
+    return result;
+  }
 
-    Drv::I2cStatus status = this->write_out(0, this->m_I2cDevAddress, buffer);
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    verifyConfig()
+  {
+    Fw::Buffer buffer(this->m_verifyData, sizeof this->m_verifyData);
+    const Drv::I2cStatus status = readRegisterBlock(ConfigShadow::FIRST_ADDR, buffer);
     if (status != Drv::I2cStatus::I2C_OK) {
       this->log_WARNING_HI_ConfigError(status);
+      return;
     }
 
+    // a device that lost power behind our back comes back with its reset values
+    U8 address = 0;
+    U8 expected = 0;
+    const FwSizeType mismatches = this->m_shadow.verify(this->m_verifyData, address, expected);
+    if (mismatches == 0) {
+      return;
+    }
+    this->m_configMismatches += static_cast<U32>(mismatches);
+    this->tlmWrite_configMismatches(this->m_configMismatches);
+    this->log_WARNING_HI_ConfigMismatch(address, this->m_verifyData[address - ConfigShadow::FIRST_ADDR], expected,
+                                        static_cast<U8>(mismatches));
+    flushConfig();
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configDecimator()
+  {
+    Fw::ParamValid valid;
+    const DecimationFilter filter = this->paramGet_DECIMATION_FILTER(valid);
+    const U8 ratio = this->paramGet_DECIMATION_RATIO(valid);
+    const FirTaps firTaps = this->paramGet_FIR_TAPS(valid);
+
+    F32 taps[DECIMATOR_MAX_TAPS];
+    for (FwSizeType k = 0; k < DECIMATOR_MAX_TAPS; k++) {
+      taps[k] = firTaps[k];
+    }
+
+    SampleDecimator::Type type = SampleDecimator::PASS_THROUGH;
+    switch (filter.e) {
+      case DecimationFilter::MOVING_AVERAGE:
+        type = SampleDecimator::MOVING_AVERAGE;
+        break;
+      case DecimationFilter::CIC:
+        type = SampleDecimator::CIC;
+        break;
+      case DecimationFilter::FIR:
+        type = SampleDecimator::FIR;
+        break;
+      default:
+        break;
+    }
+
+    if (!this->m_decimator.configure(type, ratio, taps, DECIMATOR_MAX_TAPS)) {
+      this->log_WARNING_LO_DecimationConfigError(filter, ratio);
+      (void) this->m_decimator.configure(SampleDecimator::PASS_THROUGH, 1, nullptr, 0);
+    }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configDeadbands()
+  {
+    // read once here so the tick compares against members rather than taking the parameter lock
+    Fw::ParamValid valid;
+    const U16 heartbeat = this->paramGet_TLM_HEARTBEAT(valid);
+    this->m_accelDeadband.configure(this->paramGet_ACCEL_DEADBAND(valid), heartbeat);
+    this->m_gyroDeadband.configure(this->paramGet_GYRO_DEADBAND(valid), heartbeat);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configTlmFormat()
+  {
+    Fw::ParamValid valid;
+    this->m_accelRaw = (this->paramGet_ACCEL_TLM_FORMAT(valid) == TlmFormat::RAW);
+    this->m_gyroRaw = (this->paramGet_GYRO_TLM_FORMAT(valid) == TlmFormat::RAW);
+  }
 
-    data[0] = GYRO_CONFIG_ADDR;
-    data[1] = 0;      // sets the gyro sensitivity to +-250 deg/
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    configFifo()
+  {
+    Drv::I2cStatus status;
+
+    if (this->m_mode == AcquisitionMode::FIFO) {
+      // FIFO_RESET is only honoured while the FIFO is disabled, so stop it, clear it, then enable it and select what
+      // is queued
+      const U8 sequence[][2] = {
+        {FIFO_EN_ADDR, 0},
+        {USER_CTRL_ADDR, 0},
+        {USER_CTRL_ADDR, USER_CTRL_FIFO_RESET},
+        {USER_CTRL_ADDR, USER_CTRL_FIFO_EN},
+        {FIFO_EN_ADDR, FIFO_EN_ACCEL_GYRO}
+      };
+      status = Drv::I2cStatus::I2C_OK;
+      for (FwSizeType i = 0; (i < FW_NUM_ARRAY_ELEMENTS(sequence)) && (status == Drv::I2cStatus::I2C_OK); i++) {
+        status = writeRegister(sequence[i][0], sequence[i][1]);
+      }
+      // the frames after a reset do not follow on from the last drain
+      this->m_sampleClock.restart();
+    }
+    else {
+      status = writeRegister(USER_CTRL_ADDR, 0);
+      if (status == Drv::I2cStatus::I2C_OK) {
+        status = writeRegister(FIFO_EN_ADDR, 0);
+      }
+    }
 
-    status = this->write_out(0, this->m_I2cDevAddress, buffer);
     if (status != Drv::I2cStatus::I2C_OK) {
       this->log_WARNING_HI_ConfigError(status);
     }
   }
 
-  void AccelGyro ::
+  template <class Base>
+  bool AccelGyroCore<Base> ::
     power(Fw::On powerState)
   {
-    // Create a buffer/array of 2 elements each of which is 1 byte (for sending data over I2C)
-    U8 data[REG_SIZE_BYTES * 2];  
-    Fw::Buffer buffer(data, sizeof data);
-
-    // Check if already on or already off
-    if (powerState == this->m_power) {
-      return;
+    // An off device is left alone, an on one is checked again in case it has lost its configuration
+    if ((powerState == Fw::On::OFF) && (this->m_power == Fw::On::OFF)) {
+      return true;
     }
-  
-    // [0] = hardware register address
-    // [1] = bits to set the register
-    data[0] = POWER_MGMT_ADDR;
-    data[1] = (powerState == Fw::On::ON) ? POWER_ON : POWER_OFF;
 
-    // send power commands to device over I2C
-    Drv::I2cStatus powerStatus = this->write_out(0, this->m_I2cDevAddress, buffer);
+    // send power commands to device over I2C, skipped when the device is known to be in that state already
+    this->m_shadow.stage(POWER_MGMT_ADDR, (powerState == Fw::On::ON) ? POWER_ON : POWER_OFF);
+    const Drv::I2cStatus powerStatus = flushRegisters();
     if (powerStatus != Drv::I2cStatus::I2C_OK) {          // check success
       this->log_WARNING_HI_PowerModeError(powerStatus);
+      return false;
     }
     else {
       this->m_power = powerState;
 
       if (powerState == Fw::On::ON) {
+        // the device answered so any backoff from before it was turned off no longer applies, and the first sample is
+        // sent whatever the deadbands
+        this->m_backoffTicks = 0;
+        this->m_accelDeadband.reset();
+        this->m_gyroDeadband.reset();
         config();
+        verifyConfig();
+
+        // FIFO is disabled at power on so only needs setting up when it is used. It goes last, once a device that
+        // lost its configuration has been repaired: USER_CTRL is not shadowed, so nothing else puts its FIFO enable
+        // back, and the frame clock starts again from the reset
+        if (this->m_mode == AcquisitionMode::FIFO) {
+          configFifo();
+        }
+      }
+      else {
+        // nothing more is coming, the recorder and downlink get the partial chunk and batch
+        flushRecord();
+        flushBatch();
       }
     }
+    return true;
   }
 
-  void AccelGyro ::
-    updateAccel()
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    acquire(U64 edgeUs)
+  {
+    // a failing bus is left alone for a while rather than retried every tick, edges during it are only skipped
+    if (this->m_backoffTicks > 0) {
+      if (this->m_mode != AcquisitionMode::DATA_READY) {
+        this->m_backoffTicks--;
+      }
+      return;
+    }
+    if (this->isConnected_jobOut_OutputPort(0)) {
+      // the bus manager does the reads, telemetry follows in jobDone
+      startJob(edgeUs);
+    }
+    else {
+      this->m_profiler.start();
+      if (this->m_mode == AcquisitionMode::FIFO) {
+        drainFifo();
+      }
+      else {
+        updateSample(edgeUs);
+      }
+      this->m_profiler.finish();
+    }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    updateSample(U64 edgeUs)
   {
     U8 data[MAX_DATA_SIZE];
     Fw::Buffer buffer(data, sizeof data);
-    
-    // reads the block of 6 registers from the MPU 6050 at accel's address
-    Drv::I2cStatus status = readRegisterBlock(ACCEL_RAW_DATA_START, buffer);
 
-    // verify successful read before processing data
-    if ((status == Drv::I2cStatus::I2C_OK) && (buffer.getSize() == 6) && (buffer.getData() != nullptr)) {
-      F32x3 vect = deserializeVector(buffer, accelScaleFactor);
-      this->tlmWrite_accelerometer(vect);
+    // reads accel, temperature and gyro (0x3B..0x48) from the MPU 6050 in a single transaction
+    Drv::I2cStatus status = readRegisterBlock(SAMPLE_DATA_START, buffer);
+    this->m_profiler.mark(STAGE_BUS);
+    publishSample(status, buffer, edgeUs);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    drainFifo()
+  {
+    U8 countData[FIFO_COUNT_SIZE];
+    Fw::Buffer countBuffer(countData, sizeof countData);
+
+    Drv::I2cStatus status = readRegisterBlock(FIFO_COUNT_H_ADDR, countBuffer);
+    this->m_profiler.mark(STAGE_BUS);
+    const U32 frames = fifoFramesQueued(status, countBuffer);
+    if (frames == 0) {
+      return;
+    }
+
+    // FIFO_R_W does not auto-increment so every queued frame comes out of one block read
+    Fw::Buffer buffer(this->m_fifoData, frames * FIFO_FRAME_SIZE);
+    status = readRegisterBlock(FIFO_R_W_ADDR, buffer);
+    this->m_profiler.mark(STAGE_BUS);
+    publishFrames(status, buffer, frames);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    startJob(U64 edgeUs)
+  {
+    // one job in flight, a tick that finds the last one still running is skipped rather than queued behind it
+    if (this->m_jobPending) {
+      this->m_overruns++;
+      this->tlmWrite_acquisitionOverruns(this->m_overruns);
+      return;
+    }
+
+    // bus time runs from here to the completion, queueing behind other devices included
+    this->m_profiler.start();
+    if (this->m_mode == AcquisitionMode::FIFO) {
+      submitJob(JOB_FIFO_COUNT, FIFO_COUNT_H_ADDR, this->m_fifoCountData, FIFO_COUNT_SIZE);
     }
     else {
-      this->log_WARNING_HI_TelemetryError(status);
+      // the edge time stays with the job, an edge that overruns it must not re-date it
+      this->m_jobEdgeUs = edgeUs;
+      submitJob(JOB_SAMPLE, SAMPLE_DATA_START, this->m_sampleData, MAX_DATA_SIZE);
     }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    submitJob(U32 stage, U8 startRegisterAddress, U8* data, U32 size)
+  {
+    this->m_jobRegister = startRegisterAddress;
+    Fw::Buffer writeBuffer(&this->m_jobRegister, REG_SIZE_BYTES);
+    Fw::Buffer readBuffer(data, size);
 
+    this->m_jobPending = true;
+    this->jobOut_out(0, stage, this->m_I2cDevAddress, writeBuffer, readBuffer);
   }
 
-  void AccelGyro ::
-    updateGyro()
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    publishSample(Drv::I2cStatus status, const Fw::Buffer& buffer, U64 edgeUs)
   {
-    U8 data[MAX_DATA_SIZE];
-    Fw::Buffer buffer(data, sizeof data);
+    const U8* const data = buffer.getData();
 
-    Drv::I2cStatus status = readRegisterBlock(GYRO_RAW_DATA_START, buffer);
+    // verify successful read before processing data
+    if ((status == Drv::I2cStatus::I2C_OK) && (buffer.getSize() == MAX_DATA_SIZE) && (data != nullptr)) {
+      // registers are laid out as accel x/y/z, temperature, gyro x/y/z; everything is decoded before anything is sent
+      const bool decimating = (this->m_decimator.type() != SampleDecimator::PASS_THROUGH);
+      const bool sampling = this->isConnected_sampleOut_OutputPort(0);
+      const bool ringing = (this->m_ring != nullptr);
+      F32x3 accel;
+      F32x3 gyro;
+      if (sampling || ringing || !decimating) {
+        accel = deserializeVector(&data[ACCEL_DATA_OFFSET], this->m_accelScale);
+        gyro = deserializeVector(&data[GYRO_DATA_OFFSET], this->m_gyroScale);
+      }
+      const F32 temperature = SampleDecode::scaleAxis(&data[TEMP_DATA_OFFSET], tempScaleFactor) + tempOffset;
+      const bool filtered = decimating && decimate(&data[ACCEL_DATA_OFFSET], &data[GYRO_DATA_OFFSET]);
+      this->m_profiler.mark(STAGE_DECODE);
+
+      const bool capture = this->isConnected_recordOut_OutputPort(0) || this->isConnected_batchOut_OutputPort(0);
+      if (capture || sampling || ringing) {
+        // a sample read on its data-ready edge is dated by the edge, not by when the read finished
+        const U64 timeUs = (edgeUs != 0) ? edgeUs : nowUs();
+        if (capture) {
+          captureSample(&data[ACCEL_DATA_OFFSET], &data[GYRO_DATA_OFFSET], timeUs);
+        }
+        if (ringing) {
+          const F32 accelOut[3] = {accel[0], accel[1], accel[2]};
+          const F32 gyroOut[3] = {gyro[0], gyro[1], gyro[2]};
+          this->m_ring->begin(1);
+          this->m_ring->put(accelOut, gyroOut, timeUs);
+          this->m_ring->commit();
+        }
+        if (sampling) {
+          this->sampleOut_out(0, accel, gyro, timeUs);
+        }
+      }
 
-    // verify successful read
-    if ((status == Drv::I2cStatus::I2C_OK) && (buffer.getSize() == 6) && (buffer.getData() != nullptr)) {
-      F32x3 vect = deserializeVector(buffer, gyroScaleFactor);
-      this->tlmWrite_gyroscope(vect);
+      this->tlmWrite_temperature(temperature);
+      if (!decimating) {
+        publishVectors(accel, gyro, countsVector(&data[ACCEL_DATA_OFFSET]), countsVector(&data[GYRO_DATA_OFFSET]));
+      }
+      else if (filtered) {
+        publishDecimated();
+      }
+      this->m_profiler.mark(STAGE_PUBLISH);
+      readSucceeded();
     }
     else {
-      this->log_WARNING_HI_TelemetryError(status);
+      readFailed(status);
+    }
+  }
+
+  template <class Base>
+  bool AccelGyroCore<Base> ::
+    decimate(const U8* accel, const U8* gyro)
+  {
+    const I16 sample[DECIMATOR_CHANNELS] = {
+        SampleDecode::rawAxis(&accel[0]), SampleDecode::rawAxis(&accel[2]), SampleDecode::rawAxis(&accel[4]),
+        SampleDecode::rawAxis(&gyro[0]), SampleDecode::rawAxis(&gyro[2]), SampleDecode::rawAxis(&gyro[4])};
+    return this->m_decimator.push(sample);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    publishDecimated()
+  {
+    // the filter runs in raw counts so scaling happens once per output, raw telemetry rounds it back to whole counts
+    const F32* const out = this->m_decimator.output();
+    publishVectors(F32x3(out[0] / this->m_accelScale, out[1] / this->m_accelScale, out[2] / this->m_accelScale),
+                   F32x3(out[3] / this->m_gyroScale, out[4] / this->m_gyroScale, out[5] / this->m_gyroScale),
+                   I16x3(SampleDecode::roundCount(out[0]), SampleDecode::roundCount(out[1]),
+                         SampleDecode::roundCount(out[2])),
+                   I16x3(SampleDecode::roundCount(out[3]), SampleDecode::roundCount(out[4]),
+                         SampleDecode::roundCount(out[5])));
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    publishVectors(const F32x3& accel, const F32x3& gyro, const I16x3& accelCounts, const I16x3& gyroCounts)
+  {
+    // the deadbands work in physical units so they mean the same in either format
+    if (this->m_accelDeadband.pass(accel[0], accel[1], accel[2])) {
+      if (this->m_accelRaw) {
+        this->tlmWrite_accelerometerRaw(accelCounts);
+      }
+      else {
+        this->tlmWrite_accelerometer(accel);
+      }
+    }
+    if (this->m_gyroDeadband.pass(gyro[0], gyro[1], gyro[2])) {
+      if (this->m_gyroRaw) {
+        this->tlmWrite_gyroscopeRaw(gyroCounts);
+      }
+      else {
+        this->tlmWrite_gyroscope(gyro);
+      }
+    }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    captureSample(const U8* accel, const U8* gyro, U64 timeUs)
+  {
+    recordSample(accel, gyro, timeUs);
+    batchSample(accel, gyro, timeUs);
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    recordSample(const U8* accel, const U8* gyro, U64 timeUs)
+  {
+    if (!this->isConnected_recordAllocate_OutputPort(0) || !this->isConnected_recordOut_OutputPort(0)) {
+      return;
+    }
+
+    // records hold a U32 offset from the chunk time, a sample the chunk cannot date goes in a new chunk
+    if ((this->m_record.getSize() > 0) &&
+        ((timeUs < this->m_recordBaseUs) || ((timeUs - this->m_recordBaseUs) > 0xFFFFFFFFu))) {
+      flushRecord();
+    }
+    if ((this->m_record.getSize() == 0) && !startChunk(timeUs)) {
+      this->m_recordsDropped++;
+      this->tlmWrite_recordsDropped(this->m_recordsDropped);
+      return;
+    }
+
+    // samples are stored as read from the device, the decode is left to the ground
+    U8* const record = this->m_record.getData() + RawRecord::HEADER_SIZE + this->m_recordCount * RawRecord::RECORD_SIZE;
+    RawRecord::putRecord(record, static_cast<U32>(timeUs - this->m_recordBaseUs), accel, gyro);
+    this->m_recordCount++;
+
+    if (this->m_recordCount == RawRecord::RECORDS_PER_CHUNK) {
+      flushRecord();
     }
   }
 
+  template <class Base>
+  bool AccelGyroCore<Base> ::
+    startChunk(U64 timeUs)
+  {
+    Fw::Buffer buffer = this->recordAllocate_out(0, RawRecord::CHUNK_SIZE);
+    if (buffer.getSize() == 0) {
+      return false;
+    }
+    FW_ASSERT(buffer.getSize() >= RawRecord::CHUNK_SIZE, buffer.getSize());
+    FW_ASSERT(buffer.getData() != nullptr);
+
+    this->m_record = buffer;
+    this->m_record.setSize(RawRecord::CHUNK_SIZE);
+    this->m_recordCount = 0;
+    this->m_recordBaseUs = timeUs;
+
+    RawRecord::putHeader(this->m_record.getData(), 0, this->getIdBase(), timeUs);
+    return true;
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    flushRecord()
+  {
+    if (this->m_record.getSize() == 0) {
+      return;
+    }
+
+    // chunks always go out whole so every write the recorder makes is the same size
+    U8* const data = this->m_record.getData();
+    const FwSizeType used = RawRecord::HEADER_SIZE + this->m_recordCount * RawRecord::RECORD_SIZE;
+    RawRecord::putU16(&data[RawRecord::COUNT_OFFSET], static_cast<U16>(this->m_recordCount));
+    memset(&data[used], 0, RawRecord::CHUNK_SIZE - used);
+
+    this->recordOut_out(0, this->m_record);
+    this->m_record = Fw::Buffer();
+    this->m_recordCount = 0;
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    batchSample(const U8* accel, const U8* gyro, U64 timeUs)
+  {
+    if (!this->isConnected_batchOut_OutputPort(0)) {
+      return;
+    }
+
+    // same dating rule as the chunks, a sample the batch cannot date starts the next one
+    if ((this->m_batchCount > 0) &&
+        ((timeUs < this->m_batchBaseUs) || ((timeUs - this->m_batchBaseUs) > 0xFFFFFFFFu))) {
+      flushBatch();
+    }
+    if (this->m_batchCount == 0) {
+      this->m_batchBaseUs = timeUs;
+    }
+
+    U8* const record = &this->m_batch[RawRecord::HEADER_SIZE + this->m_batchCount * RawRecord::RECORD_SIZE];
+    RawRecord::putRecord(record, static_cast<U32>(timeUs - this->m_batchBaseUs), accel, gyro);
+    this->m_batchCount++;
+
+    if (this->m_batchCount == BATCH_RECORDS) {
+      flushBatch();
+    }
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    flushBatch()
+  {
+    if (this->m_batchCount == 0) {
+      return;
+    }
+
+    // one header for the whole batch, and only the records that were filled go on the link
+    RawRecord::putHeader(this->m_batch, static_cast<U16>(this->m_batchCount), this->getIdBase(), this->m_batchBaseUs);
+    Fw::ComBuffer packet;
+    Fw::SerializeStatus status =
+        packet.serialize(static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_HAND));
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+    status = packet.serialize(this->m_batch, RawRecord::HEADER_SIZE + this->m_batchCount * RawRecord::RECORD_SIZE,
+                              Fw::Serialization::OMIT_LENGTH);
+    FW_ASSERT(status == Fw::FW_SERIALIZE_OK, status);
+
+    this->batchOut_out(0, packet, 0);
+    this->m_batchCount = 0;
+  }
+
+  template <class Base>
+  U64 AccelGyroCore<Base> ::
+    nowUs()
+  {
+    const Fw::Time now = this->getTime();
+    return static_cast<U64>(now.getSeconds()) * 1000000 + now.getUSeconds();
+  }
+
+  template <class Base>
+  U32 AccelGyroCore<Base> ::
+    fifoFramesQueued(Drv::I2cStatus status, const Fw::Buffer& buffer)
+  {
+    if ((status != Drv::I2cStatus::I2C_OK) || (buffer.getSize() != FIFO_COUNT_SIZE)) {
+      readFailed(status);
+      return 0;
+    }
+    readSucceeded();
+
+    // FIFO_COUNT_H/L hold the number of bytes queued, big-endian
+    const U8* const countData = buffer.getData();
+    const U16 fifoCount = static_cast<U16>((countData[0] << 8) | countData[1]);
+
+    // a full FIFO overwrites its oldest bytes so frame alignment is lost, start over
+    if (fifoCount >= FIFO_SIZE_BYTES) {
+      this->m_fifoOverflows++;
+      this->tlmWrite_fifoOverflows(this->m_fifoOverflows);
+      this->log_WARNING_HI_FifoOverflow(fifoCount);
+      configFifo();
+      return 0;
+    }
+
+    // partial frames are left queued for the next tick
+    const U32 frames = fifoCount / FIFO_FRAME_SIZE;
+    FW_ASSERT(frames <= FIFO_MAX_FRAMES, frames);
+    this->tlmWrite_fifoFramesDrained(frames);
+    return frames;
+  }
+
+  template <class Base>
+  void AccelGyroCore<Base> ::
+    publishFrames(Drv::I2cStatus status, const Fw::Buffer& buffer, U32 frames)
+  {
+    FW_ASSERT(frames <= FIFO_MAX_FRAMES, frames);
+    if ((status != Drv::I2cStatus::I2C_OK) || (buffer.getSize() != frames * FIFO_FRAME_SIZE)) {
+      // the frames are gone from the FIFO, the next drain does not follow on from the last
+      this->m_sampleClock.restart();
+      readFailed(status);
+      return;
+    }
+
+    // frames are queued as accel x/y/z, gyro x/y/z; every frame goes through the filter, and is scaled when sampleOut
+    // or unfiltered telemetry needs it
+    const U8* const raw = buffer.getData();
+    const bool decimating = (this->m_decimator.type() != SampleDecimator::PASS_THROUGH);
+    const bool sampling = this->isConnected_sampleOut_OutputPort(0);
+    const bool ringing = (this->m_ring != nullptr);
+    if (sampling || ringing || !decimating) {
+      SampleDecode::decodeFrames(raw, frames, this->m_accelScale, this->m_gyroScale, this->m_frames);
+    }
+    bool ready = false;
+    if (decimating) {
+      for (U32 i = 0; i < frames; i++) {
+        const U8* const frame = &raw[i * FIFO_FRAME_SIZE];
+        ready = decimate(&frame[0], &frame[6]) || ready;
+      }
+    }
+    this->m_profiler.mark(STAGE_DECODE);
+
+    // one clock read dates the whole drain, the frames before the newest are a tracked sample period apart
+    const bool capture = this->isConnected_recordOut_OutputPort(0) || this->isConnected_batchOut_OutputPort(0);
+    this->m_sampleClock.drain(nowUs(), frames);
+    this->tlmWrite_sampleClockDrift(this->m_sampleClock.driftPpm());
+    if (capture || sampling || ringing) {
+      // the whole drain reaches ring readers at once
+      if (ringing) {
+        this->m_ring->begin(frames);
+      }
+      for (U32 i = 0; i < frames; i++) {
+        const U64 timeUs = this->m_sampleClock.frameUs(frames - 1 - i);
+        if (capture) {
+          const U8* const frame = &raw[i * FIFO_FRAME_SIZE];
+          captureSample(&frame[0], &frame[6], timeUs);
+        }
+        if (ringing) {
+          this->m_ring->put(this->m_frames[i].accel, this->m_frames[i].gyro, timeUs);
+        }
+        if (sampling) {
+          const SampleDecode::ScaledFrame& scaled = this->m_frames[i];
+          this->sampleOut_out(0, F32x3(scaled.accel[0], scaled.accel[1], scaled.accel[2]),
+                              F32x3(scaled.gyro[0], scaled.gyro[1], scaled.gyro[2]), timeUs);
+        }
+      }
+      if (ringing) {
+        this->m_ring->commit();
+      }
+    }
+
+    // telemetry carries the newest frame, or the newest filter output; with the ratio matched to the frames per tick
+    // that is one output built from every sample since the last tick
+    if (!decimating) {
+      const SampleDecode::ScaledFrame& newest = this->m_frames[frames - 1];
+      const U8* const newestRaw = &raw[(frames - 1) * FIFO_FRAME_SIZE];
+      publishVectors(F32x3(newest.accel[0], newest.accel[1], newest.accel[2]),
+                     F32x3(newest.gyro[0], newest.gyro[1], newest.gyro[2]), countsVector(&newestRaw[0]),
+                     countsVector(&newestRaw[6]));
+    }
+    else if (ready) {
+      publishDecimated();
+    }
+    this->m_profiler.mark(STAGE_PUBLISH);
+  }
+
+  // both variants are built here, after every shared definition
+  template class AccelGyroCore<AccelGyroComponentBase>;
+  template class AccelGyroCore<ActiveAccelGyroComponentBase>;
+
 }
@@ -8,11 +8,29 @@
 #define Components_AccelGyro_HPP
 
 #include "Components/AccelGyro/AccelGyroComponentAc.hpp"
+#include "Components/AccelGyro/Deadband.hpp"
+#include "Components/AccelGyro/Decimator.hpp"
+#include "Components/AccelGyro/RawRecord.hpp"
+#include "Components/AccelGyro/RegisterShadow.hpp"
+#include "Components/AccelGyro/SampleClock.hpp"
+#include "Components/AccelGyro/SampleDecode.hpp"
+#include "Components/AccelGyro/SampleRing.hpp"
+#include "Components/AccelGyro/StageProfiler.hpp"
 
 namespace Components {
 
-  class AccelGyro :
-    public AccelGyroComponentBase
+  /**
+   * \brief everything AccelGyro and ActiveAccelGyro share, over the autocoded base of either
+   *
+   * The two components are built from the same FPP members so their bases have the same ports, telemetry, events and
+   * parameters, and differ only in whether commands and input ports are guarded or queued. Each variant adds its own
+   * init and parameter update hook.
+   *
+   * \tparam Base: AccelGyroComponentBase or ActiveAccelGyroComponentBase
+   */
+  template <class Base>
+  class AccelGyroCore :
+    public Base
   {
 
     public:
@@ -26,37 +44,116 @@ namespace Components {
     };
 
     static const U8 POWER_MGMT_ADDR = 0x6B;
+    static const U8 SMPLRT_DIV_ADDR = 0x19;
     static const U8 GYRO_CONFIG_ADDR = 0x1B;
     static const U8 ACCEL_CONFIG_ADDR = 0x1C;
     static const U8 DEVICE_CONFIG_ADDR = 0x1A;
     static const U8 GYRO_RAW_DATA_START = 0x43;
     static const U8 ACCEL_RAW_DATA_START = 0x3B;
+    static const U8 TEMP_RAW_DATA_START = 0x41;
+    static const U8 FIFO_EN_ADDR = 0x23;
+    static const U8 USER_CTRL_ADDR = 0x6A;
+    static const U8 FIFO_COUNT_H_ADDR = 0x72;
+    static const U8 FIFO_R_W_ADDR = 0x74;
+    static const U8 INT_PIN_CFG_ADDR = 0x37;
+    static const U8 INT_ENABLE_ADDR = 0x38;
     static const U8 POWER_ON = 0x00;
     static const U8 POWER_OFF = 0x40;
 
-    static const U16 MAX_DATA_SIZE = 6;
+    // FIFO_EN bits for XG, YG, ZG and ACCEL, queues 12-byte accel/gyro frames
+    static const U8 FIFO_EN_ACCEL_GYRO = 0x78;
+    static const U8 USER_CTRL_FIFO_EN = 0x40;
+    static const U8 USER_CTRL_FIFO_RESET = 0x04;
+
+    // INT pulses for 50 us on each new sample in DATA_READY mode and is otherwise unused. The pin is not latched, so an
+    // edge skipped in a backoff, dropped as an overrun or read unsuccessfully leaves nothing to clear and the next
+    // sample pulses it again; the status clears on the sample read, so nothing extra is read per sample
+    static const U8 INT_ENABLE_NONE = 0x00;
+    static const U8 INT_ENABLE_DATA_RDY = 0x01;
+    static const U8 INT_PIN_CFG_DEFAULT = 0x00;
+    static const U8 INT_PIN_CFG_RD_CLEAR = 0x10;
+    static const U8 INT_PIN_CFG_DATA_RDY = INT_PIN_CFG_RD_CLEAR;
+
+    // configuration registers are shadowed over SMPLRT_DIV..PWR_MGMT_1 and verified with one burst read of the window;
+    // the read passes over INT_STATUS, which clears it, and stops short of FIFO_R_W so it never pops the FIFO
+    typedef RegisterShadow<SMPLRT_DIV_ADDR, POWER_MGMT_ADDR> ConfigShadow;
+
+    // accel, temperature and gyro registers are contiguous (0x3B..0x48) and are read in one burst
+    static const U8 SAMPLE_DATA_START = ACCEL_RAW_DATA_START;
+    static const U16 MAX_DATA_SIZE = 14;
+    static const U16 ACCEL_DATA_OFFSET = 0;
+    static const U16 TEMP_DATA_OFFSET = 6;
+    static const U16 GYRO_DATA_OFFSET = 8;
     static const U16 REG_SIZE_BYTES = 1;
 
+    static const U16 FIFO_SIZE_BYTES = 1024;
+    static const U16 FIFO_COUNT_SIZE = 2;
+    static const U16 FIFO_FRAME_SIZE = 12;
+    static const U16 FIFO_MAX_FRAMES = FIFO_SIZE_BYTES / FIFO_FRAME_SIZE;
+
     static constexpr float accelScaleFactor = 16384.0f;
     static constexpr float gyroScaleFactor = 131.072f;
+    static constexpr float tempScaleFactor = 340.0f;
+    static constexpr float tempOffset = 36.53f;
+
+    // AFS_SEL and FS_SEL sit in bits 4:3 of ACCEL_CONFIG and GYRO_CONFIG
+    static const U8 FULL_SCALE_SHIFT = 3;
+    static const U8 NUM_FULL_SCALE_RANGES = 4;
+
+    // scale factor per AccelRange / GyroRange, each step doubles the span, looked up once at config time
+    static constexpr float accelScaleFactors[NUM_FULL_SCALE_RANGES] = {
+        accelScaleFactor, accelScaleFactor / 2.0f, accelScaleFactor / 4.0f, accelScaleFactor / 8.0f};
+    static constexpr float gyroScaleFactors[NUM_FULL_SCALE_RANGES] = {
+        gyroScaleFactor, gyroScaleFactor / 2.0f, gyroScaleFactor / 4.0f, gyroScaleFactor / 8.0f};
+
+    // decimation filters accel x/y/z then gyro x/y/z; the ring holds more than one full FIFO drain
+    static const FwSizeType DECIMATOR_CHANNELS = 6;
+    static const FwSizeType DECIMATOR_RING_SIZE = 128;
+    static const FwSizeType DECIMATOR_MAX_TAPS = FirTaps::SIZE;
+    typedef Decimator<DECIMATOR_CHANNELS, DECIMATOR_RING_SIZE, DECIMATOR_MAX_TAPS> SampleDecimator;
+
+    // gyro output period with the DLPF off and on, SMPLRT_DIV stretches it to the sample period
+    static const U32 GYRO_PERIOD_US_DLPF_OFF = 125;
+    static const U32 GYRO_PERIOD_US_DLPF_ON = 1000;
+
+    // a batch packet is the descriptor, a raw record header and as many records as fit in one com buffer
+    static const FwSizeType BATCH_RECORDS =
+        (FW_COM_BUFFER_MAX_SIZE - sizeof(FwPacketDescriptorType) - RawRecord::HEADER_SIZE) / RawRecord::RECORD_SIZE;
+    static const FwSizeType BATCH_DATA_SIZE = RawRecord::HEADER_SIZE + BATCH_RECORDS * RawRecord::RECORD_SIZE;
+
+    //! Stages of a tick timed by the profiler, each has a latency channel
+    enum Stage {
+      STAGE_BUS,      //!< I2C transactions, from queueing to completion with a bus manager
+      STAGE_DECODE,   //!< scaling and filtering
+      STAGE_PUBLISH,  //!< telemetry and output ports
+      STAGE_TICK,     //!< the whole tick
+      NUM_STAGES
+    };
+    typedef StageProfiler<NUM_STAGES> TickProfiler;
+
+    // decoded samples shared with any number of readers, about a second of samples at 1 kHz
+    static const FwSizeType SAMPLE_RING_SIZE = 1024;
+    typedef SampleRing<SAMPLE_RING_SIZE> ImuSampleRing;
       // ----------------------------------------------------------------------
       // Component construction and destruction
       // ----------------------------------------------------------------------
 
-      //! Construct AccelGyro object
-      AccelGyro(
+      //! Construct AccelGyroCore object
+      AccelGyroCore(
           const char* const compName //!< The component name
       );
-      
-      //! Initialize object AccelGyro
-      void init(const NATIVE_INT_TYPE instance = 0);
 
-      //! Destroy AccelGyro object
-      ~AccelGyro();
+      //! Destroy AccelGyroCore object
+      virtual ~AccelGyroCore();
 
       void setup(I2cAddr::T devAddress);
 
-    PRIVATE:
+      //! Publish every decoded sample, FIFO frames included, to a ring for readers on other threads
+      //!
+      //! Set before the rate groups start, the ring must outlive the component.
+      void setSampleRing(ImuSampleRing* ring);
+
+    PROTECTED:
 
       // ----------------------------------------------------------------------
       // Handler implementations for typed input ports
@@ -70,7 +167,42 @@ namespace Components {
           U32 context //!< The call order
       ) override;
 
-    PRIVATE:
+      //! Handler implementation for jobDone
+      //!
+      //! Port for receiving bus manager completions
+      void jobDone_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context, //!< tag the job was submitted with
+          const Drv::I2cStatus& status, //!< status of the first transaction that failed, or I2C_OK
+          const Fw::Buffer& readBuffer //!< the job's read buffer, filled when status is I2C_OK
+      ) override;
+
+      //! Handler implementation for latencyRun
+      //!
+      //! Port for sending the stage latency histograms, driven from a slow rate group
+      void latencyRun_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context //!< The call order
+      ) override;
+
+      //! Handler implementation for dataReady
+      //!
+      //! Port for receiving data-ready edges from the INT pin, each one reads a sample in DATA_READY mode
+      void dataReady_handler(
+          FwIndexType portNum, //!< The port number
+          U64 timeUs //!< time of the edge, on the clock samples are dated with
+      ) override;
+
+    PROTECTED:
+
+      // ----------------------------------------------------------------------
+      // Parameter loaded hook
+      // ----------------------------------------------------------------------
+
+      //! Sets up the decimation filter from the loaded parameters
+      void parametersLoaded() override;
+
+    PROTECTED:
 
       // ----------------------------------------------------------------------
       // Handler implementations for commands
@@ -84,43 +216,396 @@ namespace Components {
           U32 cmdSeq, //!< The command sequence number
           Fw::On powerState //!< Indicates whether the device is on or off
       ) override;
+
+      //! Handler implementation for command SET_ACQUISITION_MODE
+      //!
+      //! Command to select how samples are acquired from the device
+      void SET_ACQUISITION_MODE_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq, //!< The command sequence number
+          Components::AcquisitionMode mode //!< register polling, FIFO drain or data-ready edges
+      ) override;
+
+      //! Handler implementation for command RESET_LATENCY
+      //!
+      //! Command to clear the stage latency histograms
+      void RESET_LATENCY_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      //! Handler implementation for command RESET_ERROR_THROTTLE
+      //!
+      //! Command to let throttled bus error events through again
+      void RESET_ERROR_THROTTLE_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
       
 
       // ----------------------------------------------------------------------
       // Helper Functions
       // ----------------------------------------------------------------------
+
+      //! Settings re-applied together when one of their parameters changes
+      enum ConfigGroup {
+        CONFIG_SAMPLE_RATE = 0x01,  //!< SAMPLE_RATE_DIVIDER and DLPF_BANDWIDTH
+        CONFIG_RANGES = 0x02,       //!< ACCEL_RANGE and GYRO_RANGE
+        CONFIG_DECIMATOR = 0x04,    //!< DECIMATION_FILTER, DECIMATION_RATIO and FIR_TAPS
+        CONFIG_DEADBANDS = 0x08,    //!< ACCEL_DEADBAND, GYRO_DEADBAND and TLM_HEARTBEAT
+        CONFIG_TLM_FORMAT = 0x10    //!< ACCEL_TLM_FORMAT and GYRO_TLM_FORMAT
+      };
+
+      /**
+       * \brief Settings a parameter belongs to
+       * \return ConfigGroup bits, 0 for a parameter nothing is applied from
+       */
+      static U32 configGroups(FwPrmIdType id);
+
+      /**
+       * \brief Re-apply groups of settings, device ones only when powered
+       * \param groups: ConfigGroup bits
+       */
+      void applyConfig(U32 groups);
+
       /**
        * \brief Turn power on/off of device
        * \param powerState: ON/OFF Type from the framework
+       * \return false when the device did not take the power state
        */
-      void power(Fw::On powerState);
+      bool power(Fw::On powerState);
 
       /**
-       * \brief Read, telemetry, and update accelerometer data
+       * \brief Read or queue this tick's samples, unless a failing bus is being backed off from
+       * \param edgeUs: time of the data-ready edge that started the read, 0 to date samples when they are read
        */
-      void updateAccel();
+      void acquire(U64 edgeUs);
 
       /**
-       * \brief Read, telemetry, and update gyroscope data
+       * \brief Read accelerometer, temperature and gyroscope data in one burst and send telemetry
+       * \param edgeUs: time of the data-ready edge, 0 to date the sample when it is read
        */
-      void updateGyro();
+      void updateSample(U64 edgeUs);
       
       /**
-       * \brief configures the accelerometer and gyroscope
+       * \brief Drain all frames queued in the device FIFO and send telemetry
+       */
+      void drainFifo();
+
+      /**
+       * \brief Queue the first read of this tick with the bus manager, or skip the tick if the last one is still running
+       * \param edgeUs: time of the data-ready edge, kept with the job, 0 to date the sample when it completes
+       */
+      void startJob(U64 edgeUs);
+
+      /**
+       * \brief Queue a register pointer write and block read with the bus manager
+       */
+      void submitJob(U32 stage, U8 startRegisterAddress, U8* data, U32 size);
+
+      /**
+       * \brief Decode a burst of the accel, temperature and gyro registers and send telemetry
+       * \param edgeUs: time of the data-ready edge the sample was read on, 0 to date it now
+       */
+      void publishSample(Drv::I2cStatus status, const Fw::Buffer& buffer, U64 edgeUs);
+
+      /**
+       * \brief Feed one raw accel/gyro sample to the decimation filter
+       * \param accel: big-endian accel x/y/z
+       * \param gyro: big-endian gyro x/y/z
+       * \return true when the filter has a new output
+       */
+      bool decimate(const U8* accel, const U8* gyro);
+
+      /**
+       * \brief Scale the newest filter output and send accel and gyro telemetry
+       */
+      void publishDecimated();
+
+      /**
+       * \brief Send accel and gyro telemetry, each only when it passes its deadband, scaled or in counts by format
+       * \param accel: accel x/y/z in g, checked against the deadband
+       * \param gyro: gyro x/y/z in deg/s, checked against the deadband
+       * \param accelCounts: the same accel sample in device counts
+       * \param gyroCounts: the same gyro sample in device counts
+       */
+      void publishVectors(const F32x3& accel, const F32x3& gyro, const I16x3& accelCounts, const I16x3& gyroCounts);
+
+      /**
+       * \brief Hand one raw sample to the recorder and the downlink batch, whichever are connected
+       * \param accel: big-endian accel x/y/z
+       * \param gyro: big-endian gyro x/y/z
+       * \param timeUs: time the sample was taken
+       */
+      void captureSample(const U8* accel, const U8* gyro, U64 timeUs);
+
+      /**
+       * \brief Append one raw sample to the current chunk, sending the chunk to the recorder once it is full
+       * \param accel: big-endian accel x/y/z
+       * \param gyro: big-endian gyro x/y/z
+       * \param timeUs: time the sample was taken
+       */
+      void recordSample(const U8* accel, const U8* gyro, U64 timeUs);
+
+      /**
+       * \brief Take a chunk buffer and write its header
+       * \return false when the buffer manager has none free
+       */
+      bool startChunk(U64 timeUs);
+
+      /**
+       * \brief Send the current chunk to the recorder, however full it is
+       */
+      void flushRecord();
+
+      /**
+       * \brief Append one raw sample to the current batch, sending the batch packet once it is full
+       */
+      void batchSample(const U8* accel, const U8* gyro, U64 timeUs);
+
+      /**
+       * \brief Send the current batch packet, however full it is
+       */
+      void flushBatch();
+
+      /**
+       * \brief Current time in microseconds, used to date samples
+       */
+      U64 nowUs();
+
+      /**
+       * \brief Check a FIFO count read, resetting the FIFO on overflow
+       * \return number of whole frames to drain
+       */
+      U32 fifoFramesQueued(Drv::I2cStatus status, const Fw::Buffer& buffer);
+
+      /**
+       * \brief Decode drained FIFO frames and send telemetry for the newest, or the filtered output when decimating
+       */
+      void publishFrames(Drv::I2cStatus status, const Fw::Buffer& buffer, U32 frames);
+
+      /**
+       * \brief Histogram, p99 and maximum of one stage as telemetry
+       */
+      StageLatency stageLatency(Stage stage) const;
+
+      /**
+       * \brief configures the accelerometer and gyroscope, the sample rate, range and interrupt registers in one burst
        */
       void config();
 
+      /**
+       * \brief stages the sample rate divider and DLPF setting from parameters
+       */
+      void stageSampleRate();
+
+      /**
+       * \brief stages the accel and gyro full-scale ranges from parameters
+       */
+      void stageRanges();
+
+      /**
+       * \brief stages the INT pin and interrupt sources for the acquisition mode
+       */
+      void stageInterrupts();
+
+      /**
+       * \brief takes the sample period from the sample rate registers the device holds
+       */
+      void sampleRateApplied();
+
+      /**
+       * \brief selects the scale factors for the ranges the device holds and reports them
+       */
+      void rangesApplied();
+
+      /**
+       * \brief writes every staged register the device does not already hold, reporting a failure as ConfigError
+       */
+      void flushConfig();
+
+      /**
+       * \brief writes every staged register the device does not already hold, one burst per run of adjacent registers
+       * \return status of the first write that failed, or I2C_OK
+       */
+      Drv::I2cStatus flushRegisters();
+
+      /**
+       * \brief reads the shadowed window back in one burst and rewrites any register that has lost its value
+       */
+      void verifyConfig();
+
+      /**
+       * \brief writes the sample rate divider and DLPF setting from parameters
+       */
+      void configSampleRate();
+
+      /**
+       * \brief writes the accel and gyro full-scale ranges from parameters and selects their scale factors
+       */
+      void configRanges();
+
+      /**
+       * \brief selects the decimation filter from parameters, falling back to no filter when they are out of range
+       */
+      void configDecimator();
+
+      /**
+       * \brief sets the accel and gyro telemetry deadbands from parameters
+       */
+      void configDeadbands();
+
+      /**
+       * \brief selects scaled or raw accel and gyro telemetry from parameters
+       */
+      void configTlmFormat();
+
+      /**
+       * \brief enables and resets, or disables, the device FIFO to match the acquisition mode
+       */
+      void configFifo();
+
+      /**
+       * \brief write one register, a shadowed register is skipped when the device already holds the value
+       */
+      Drv::I2cStatus writeRegister(U8 registerAddress, U8 value);
+
       Drv::I2cStatus readRegisterBlock(U8 startRegisterAddress, Fw::Buffer& buffer);
 
-      Drv::I2cStatus setupReadRegister(U8 registerAddress);
+      /**
+       * \brief Count a failed register write
+       */
+      void writeFailed();
 
-      F32x3 deserializeVector(Fw::Buffer& buffer, F32 scaleFactor);
+      /**
+       * \brief Count a failed read, report it and back off once failures run past BACKOFF_THRESHOLD
+       */
+      void readFailed(Drv::I2cStatus status);
+
+      /**
+       * \brief End a run of failed reads, if there was one
+       */
+      void readSucceeded();
+
+      /**
+       * \brief decode three big-endian axes and divide them by their sensitivity
+       */
+      F32x3 deserializeVector(const U8* data, F32 scaleFactor);
+
+      /**
+       * \brief decode three big-endian axes as device counts
+       */
+      I16x3 countsVector(const U8* data);
+
+      //! Reads queued with the bus manager, passed as the job context
+      enum JobStage {
+        JOB_SAMPLE,      //!< accel, temperature and gyro burst
+        JOB_FIFO_COUNT,  //!< FIFO byte count
+        JOB_FIFO_DATA    //!< whole FIFO frames
+      };
 
       // ----------------------------------------------------------------------
       // Member Variables
       // ----------------------------------------------------------------------
       Fw::On m_power = Fw::On::OFF;
       I2cAddr::T m_I2cDevAddress;
+
+      // configuration registers as last written, so unchanged values are not written again
+      ConfigShadow m_shadow;
+      U8 m_verifyData[ConfigShadow::SPAN];
+      U32 m_configMismatches = 0;
+      AcquisitionMode m_mode = AcquisitionMode::REGISTER;
+      U32 m_fifoOverflows = 0;
+
+      // scale factors for the range the device is configured with
+      F32 m_accelScale = accelScaleFactor;
+      F32 m_gyroScale = gyroScaleFactor;
+
+      // filter between acquisition and accel/gyro telemetry, works in raw counts
+      SampleDecimator m_decimator;
+
+      // ring every decoded sample is published to, none when nullptr
+      ImuSampleRing* m_ring = nullptr;
+
+      // gates on accel and gyro telemetry, in physical units
+      Deadband m_accelDeadband;
+      Deadband m_gyroDeadband;
+
+      // accel and gyro telemetry in device counts rather than g and deg/s
+      bool m_accelRaw = false;
+      bool m_gyroRaw = false;
+
+      // chunk of raw samples being filled for the recorder, empty when none is held
+      Fw::Buffer m_record;
+      U32 m_recordCount = 0;
+      U64 m_recordBaseUs = 0;
+      U32 m_recordsDropped = 0;
+
+      // batch of raw samples being filled for downlink, header first
+      U8 m_batch[BATCH_DATA_SIZE];
+      U32 m_batchCount = 0;
+      U64 m_batchBaseUs = 0;
+
+      // the device's sample clock tracked against the host's, dates the frames of a drain
+      SampleClock m_sampleClock;
+
+      // raw FIFO frames from the last drain
+      U8 m_fifoData[FIFO_MAX_FRAMES * FIFO_FRAME_SIZE];
+
+      // FIFO frames from the last drain in physical units
+      SampleDecode::ScaledFrame m_frames[FIFO_MAX_FRAMES];
+
+      // bus manager job state, the buffers belong to the job until it completes
+      bool m_jobPending = false;
+      U8 m_jobRegister = 0;
+      U32 m_jobFrames = 0;
+      U64 m_jobEdgeUs = 0;
+      U32 m_overruns = 0;
+      U8 m_sampleData[MAX_DATA_SIZE];
+      U8 m_fifoCountData[FIFO_COUNT_SIZE];
+
+      // bus error counts, and the ticks left to skip before the next read of a failing bus
+      U32 m_readErrors = 0;
+      U32 m_writeErrors = 0;
+      U32 m_consecutiveFailures = 0;
+      U16 m_backoffTicks = 0;
+
+      // stage timing, empty when built without ACCELGYRO_STAGE_PROFILING
+      TickProfiler m_profiler;
+  };
+
+  //! Passive AccelGyro, Run and commands run on the caller's thread under the component guard
+  class AccelGyro final :
+    public AccelGyroCore<AccelGyroComponentBase>
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct AccelGyro object
+      AccelGyro(
+          const char* const compName //!< The component name
+      );
+      
+      //! Initialize object AccelGyro
+      void init(const NATIVE_INT_TYPE instance = 0);
+
+      //! Destroy AccelGyro object
+      ~AccelGyro();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Parameter update hook
+      // ----------------------------------------------------------------------
+
+      //! Re-applies sample rate and filter settings to a powered device
+      void parameterUpdated(
+          FwPrmIdType id //!< The parameter ID
+      ) override;
   };
 
 }
@@ -0,0 +1,233 @@
+// ======================================================================
+// \title  ActiveAccelGyro.cpp
+// \author aidandb
+// \brief  cpp file for ActiveAccelGyro component implementation class
+// ======================================================================
+
+#include "Components/AccelGyro/ActiveAccelGyro.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ActiveAccelGyro ::
+    ActiveAccelGyro(const char* const compName) :
+      AccelGyroCore<ActiveAccelGyroComponentBase>(compName)
+  {
+
+  }
+
+  void ActiveAccelGyro ::
+    init(
+        const NATIVE_INT_TYPE queueDepth,
+        const NATIVE_INT_TYPE instance
+    )
+  {
+    FW_ASSERT(queueDepth >= ACQUISITION_MESSAGES, queueDepth);
+    ActiveAccelGyroComponentBase::init(queueDepth, instance);
+  }
+
+  ActiveAccelGyro ::
+    ~ActiveAccelGyro()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyro ::
+    Run_handler(
+        FwIndexType portNum,
+        U32 context
+    )
+  {
+    // the rate group's thread, only the flag and the counter are touched here
+    if (this->m_wakeupQueued.exchange(true, std::memory_order_acq_rel)) {
+      this->m_droppedWakeups.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    this->wakeup_internalInterfaceInvoke(context);
+  }
+
+  void ActiveAccelGyro ::
+    latencyRun_handler(
+        FwIndexType portNum,
+        U32 context
+    )
+  {
+    // a report still waiting will send the newest histograms anyway
+    if (!this->m_latencyQueued.exchange(true, std::memory_order_acq_rel)) {
+      this->latencyReport_internalInterfaceInvoke();
+    }
+  }
+
+  void ActiveAccelGyro ::
+    dataReady_handler(
+        FwIndexType portNum,
+        U64 timeUs
+    )
+  {
+    // the line's thread, the sample is lost like a dropped wake-up
+    if (this->m_edgeQueued.exchange(true, std::memory_order_acq_rel)) {
+      this->m_droppedWakeups.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    this->edge_internalInterfaceInvoke(timeUs);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for internal ports
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyro ::
+    wakeup_internalInterfaceHandler(U32 context)
+  {
+    // cleared first, so a tick that comes while this one runs is queued rather than dropped
+    this->m_wakeupQueued.store(false, std::memory_order_release);
+    betweenSamples();
+    AccelGyroCore<ActiveAccelGyroComponentBase>::Run_handler(0, context);
+  }
+
+  void ActiveAccelGyro ::
+    edge_internalInterfaceHandler(U64 timeUs)
+  {
+    // in DATA_READY mode the ticks read nothing, so commands and settings are picked up between edges as well
+    this->m_edgeQueued.store(false, std::memory_order_release);
+    betweenSamples();
+    AccelGyroCore<ActiveAccelGyroComponentBase>::dataReady_handler(0, timeUs);
+  }
+
+  void ActiveAccelGyro ::
+    latencyReport_internalInterfaceHandler()
+  {
+    this->m_latencyQueued.store(false, std::memory_order_release);
+    AccelGyroCore<ActiveAccelGyroComponentBase>::latencyRun_handler(0, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyro ::
+    POWER_ON_OFF_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq,
+        Fw::On powerState
+    )
+  {
+    pendCommand(COMMAND_POWER_ON_OFF, opCode, cmdSeq, static_cast<I32>(powerState.e));
+  }
+
+  void ActiveAccelGyro ::
+    SET_ACQUISITION_MODE_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq,
+        Components::AcquisitionMode mode
+    )
+  {
+    pendCommand(COMMAND_SET_ACQUISITION_MODE, opCode, cmdSeq, static_cast<I32>(mode.e));
+  }
+
+  void ActiveAccelGyro ::
+    RESET_LATENCY_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    pendCommand(COMMAND_RESET_LATENCY, opCode, cmdSeq, 0);
+  }
+
+  void ActiveAccelGyro ::
+    RESET_ERROR_THROTTLE_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    pendCommand(COMMAND_RESET_ERROR_THROTTLE, opCode, cmdSeq, 0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Functions
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyro ::
+    pendCommand(PendingCommand command, FwOpcodeType opCode, U32 cmdSeq, I32 arg)
+  {
+    // commands only come from the dispatcher's thread, so nothing else writes the fields between the check and the
+    // store that hands them over
+    if (this->m_pendingCommand.load(std::memory_order_acquire) != COMMAND_NONE) {
+      this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::BUSY);
+      return;
+    }
+    this->m_commandOpCode = opCode;
+    this->m_commandSeq = cmdSeq;
+    this->m_commandArg = arg;
+    this->m_pendingCommand.store(command, std::memory_order_release);
+  }
+
+  void ActiveAccelGyro ::
+    runCommand()
+  {
+    const U32 command = this->m_pendingCommand.load(std::memory_order_acquire);
+    if (command == COMMAND_NONE) {
+      return;
+    }
+    const FwOpcodeType opCode = this->m_commandOpCode;
+    const U32 cmdSeq = this->m_commandSeq;
+    const I32 arg = this->m_commandArg;
+    this->m_pendingCommand.store(COMMAND_NONE, std::memory_order_release);
+
+    switch (command) {
+      case COMMAND_POWER_ON_OFF:
+        AccelGyroCore<ActiveAccelGyroComponentBase>::POWER_ON_OFF_cmdHandler(
+            opCode, cmdSeq, Fw::On(static_cast<Fw::On::T>(arg)));
+        break;
+      case COMMAND_SET_ACQUISITION_MODE:
+        AccelGyroCore<ActiveAccelGyroComponentBase>::SET_ACQUISITION_MODE_cmdHandler(
+            opCode, cmdSeq, Components::AcquisitionMode(static_cast<Components::AcquisitionMode::T>(arg)));
+        break;
+      case COMMAND_RESET_LATENCY:
+        AccelGyroCore<ActiveAccelGyroComponentBase>::RESET_LATENCY_cmdHandler(opCode, cmdSeq);
+        break;
+      case COMMAND_RESET_ERROR_THROTTLE:
+        AccelGyroCore<ActiveAccelGyroComponentBase>::RESET_ERROR_THROTTLE_cmdHandler(opCode, cmdSeq);
+        break;
+      default:
+        FW_ASSERT(0, command);
+        break;
+    }
+  }
+
+  void ActiveAccelGyro ::
+    betweenSamples()
+  {
+    // a plain load first, the exchange only happens on the rare tick that has something to take
+    if (this->m_pendingConfig.load(std::memory_order_relaxed) != 0) {
+      applyConfig(this->m_pendingConfig.exchange(0, std::memory_order_acquire));
+    }
+    runCommand();
+    if (this->m_droppedWakeups.load(std::memory_order_relaxed) != 0) {
+      this->m_overruns += this->m_droppedWakeups.exchange(0, std::memory_order_relaxed);
+      this->tlmWrite_acquisitionOverruns(this->m_overruns);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Parameter update hook
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyro ::
+    parameterUpdated(FwPrmIdType id)
+  {
+    // runs on the command dispatcher's thread, the acquisition thread picks the settings up between samples
+    const U32 groups = configGroups(id);
+    if (groups != 0) {
+      this->m_pendingConfig.fetch_or(groups, std::memory_order_release);
+    }
+  }
+
+}
@@ -0,0 +1,185 @@
+// ======================================================================
+// \title  ActiveAccelGyro.hpp
+// \author aidandb
+// \brief  hpp file for ActiveAccelGyro component implementation class
+// ======================================================================
+
+#ifndef Components_ActiveAccelGyro_HPP
+#define Components_ActiveAccelGyro_HPP
+
+#include "Components/AccelGyro/AccelGyro.hpp"
+#include "Components/AccelGyro/ActiveAccelGyroComponentAc.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+  /**
+   * \brief AccelGyro on its own thread, everything it does is taken off its queue one message at a time
+   *
+   * Run only posts a wake-up, so the rate group never waits on the bus or on a command. Commands and parameters are
+   * taken on the command dispatcher's thread; they are only marked pending there and run at the start of the next
+   * wake-up or edge, so nothing the acquisition path touches is locked. At most one wake-up, one edge, one latency
+   * report and the one job completion are ever queued, so a thread held up on a stalled bus can never fill its queue.
+   * A tick or edge that finds the last one still queued is counted on acquisitionOverruns.
+   */
+  class ActiveAccelGyro final :
+    public AccelGyroCore<ActiveAccelGyroComponentBase>
+  {
+
+    public:
+
+      //! Messages that can be queued at once: a wake-up, an edge, a latency report and a job completion
+      static const NATIVE_INT_TYPE ACQUISITION_MESSAGES = 4;
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ActiveAccelGyro object
+      ActiveAccelGyro(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object ActiveAccelGyro
+      void init(
+          const NATIVE_INT_TYPE queueDepth, //!< The queue depth, at least ACQUISITION_MESSAGES
+          const NATIVE_INT_TYPE instance = 0
+      );
+
+      //! Destroy ActiveAccelGyro object
+      ~ActiveAccelGyro();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for Run
+      //!
+      //! Posts a wake-up unless one is already queued, on the rate group's thread
+      void Run_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context //!< The call order
+      ) override;
+
+      //! Handler implementation for latencyRun
+      //!
+      //! Posts a latency report unless one is already queued
+      void latencyRun_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context //!< The call order
+      ) override;
+
+      //! Handler implementation for dataReady
+      //!
+      //! Posts the edge unless one is already queued, on the line's thread
+      void dataReady_handler(
+          FwIndexType portNum, //!< The port number
+          U64 timeUs //!< time of the edge, on the clock samples are dated with
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for internal ports
+      // ----------------------------------------------------------------------
+
+      //! Runs pending commands and parameters, then the tick
+      void wakeup_internalInterfaceHandler(
+          U32 context //!< The call order
+      ) override;
+
+      //! Runs pending commands and parameters, then reads the edge's sample
+      void edge_internalInterfaceHandler(
+          U64 timeUs //!< time of the edge, on the clock samples are dated with
+      ) override;
+
+      //! Sends the stage latency histograms
+      void latencyReport_internalInterfaceHandler() override;
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Marks POWER_ON_OFF pending for the next wake-up
+      void POWER_ON_OFF_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq, //!< The command sequence number
+          Fw::On powerState //!< Indicates whether the device is on or off
+      ) override;
+
+      //! Marks SET_ACQUISITION_MODE pending for the next wake-up
+      void SET_ACQUISITION_MODE_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq, //!< The command sequence number
+          Components::AcquisitionMode mode //!< register polling, FIFO drain or data-ready edges
+      ) override;
+
+      //! Marks RESET_LATENCY pending for the next wake-up
+      void RESET_LATENCY_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      //! Marks RESET_ERROR_THROTTLE pending for the next wake-up
+      void RESET_ERROR_THROTTLE_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Helper Functions
+      // ----------------------------------------------------------------------
+
+      //! Commands waiting for the acquisition thread
+      enum PendingCommand {
+        COMMAND_NONE = 0,
+        COMMAND_POWER_ON_OFF,
+        COMMAND_SET_ACQUISITION_MODE,
+        COMMAND_RESET_LATENCY,
+        COMMAND_RESET_ERROR_THROTTLE
+      };
+
+      //! Hand a command to the acquisition thread, or answer BUSY while the last one is still waiting
+      void pendCommand(PendingCommand command, FwOpcodeType opCode, U32 cmdSeq, I32 arg);
+
+      //! Run the waiting command, if any, on the acquisition thread
+      void runCommand();
+
+      //! Apply pending commands and parameters and report dropped wake-ups, ahead of a tick or an edge
+      void betweenSamples();
+
+      // ----------------------------------------------------------------------
+      // Parameter update hook
+      // ----------------------------------------------------------------------
+
+      //! Marks the parameter's settings to be re-applied on the next tick
+      void parameterUpdated(
+          FwPrmIdType id //!< The parameter ID
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+
+      // ConfigGroup bits set on the command thread and taken by the next tick
+      std::atomic<U32> m_pendingConfig{0};
+
+      // PendingCommand set on the command thread once the fields below are written, cleared once they are taken
+      std::atomic<U32> m_pendingCommand{COMMAND_NONE};
+      FwOpcodeType m_commandOpCode = 0;
+      U32 m_commandSeq = 0;
+      I32 m_commandArg = 0;
+
+      // a wake-up, edge or latency report is queued and not yet taken
+      std::atomic<bool> m_wakeupQueued{false};
+      std::atomic<bool> m_edgeQueued{false};
+      std::atomic<bool> m_latencyQueued{false};
+
+      // ticks and edges that found the last one still queued, folded into m_overruns by the next tick or edge
+      std::atomic<U32> m_droppedWakeups{0};
+  };
+
+}
+
+#endif
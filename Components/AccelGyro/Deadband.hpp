@@ -0,0 +1,81 @@
+// ======================================================================
+// \title  Deadband.hpp
+// \author aidandb
+// \brief  hpp file for the deadband that gates vector telemetry
+// ======================================================================
+
+#ifndef Components_Deadband_HPP
+#define Components_Deadband_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief passes a three axis value only when it has moved, or when it has been held back too long
+   *
+   * Each value is compared with the last one passed, not the last one offered, so a slow drift still gets through once
+   * it adds up to the threshold. A threshold of zero or less passes everything.
+   */
+  class Deadband {
+
+    public:
+
+      /**
+       * \brief set the threshold and heartbeat, the next value always passes
+       * \param threshold: change on any one axis that passes a value
+       * \param heartbeat: offers after the last pass that force the next one through, 0 for none
+       */
+      void configure(F32 threshold, U32 heartbeat)
+      {
+        this->m_threshold = threshold;
+        this->m_heartbeat = heartbeat;
+        reset();
+      }
+
+      /**
+       * \brief let the next value through whatever it is
+       */
+      void reset()
+      {
+        this->m_primed = false;
+      }
+
+      /**
+       * \brief offer a value
+       * \return true when it should be published
+       */
+      bool pass(F32 x, F32 y, F32 z)
+      {
+        this->m_held++;
+        const bool moved = !this->m_primed || (this->m_threshold <= 0.0f) || exceeds(x, this->m_last[0]) ||
+                           exceeds(y, this->m_last[1]) || exceeds(z, this->m_last[2]);
+        if (!moved && ((this->m_heartbeat == 0) || (this->m_held < this->m_heartbeat))) {
+          return false;
+        }
+        this->m_last[0] = x;
+        this->m_last[1] = y;
+        this->m_last[2] = z;
+        this->m_primed = true;
+        this->m_held = 0;
+        return true;
+      }
+
+    private:
+
+      bool exceeds(F32 value, F32 last) const
+      {
+        const F32 delta = value - last;
+        return (delta > this->m_threshold) || (delta < -this->m_threshold);
+      }
+
+      F32 m_threshold = 0.0f;
+      U32 m_heartbeat = 0;
+      U32 m_held = 0;
+      F32 m_last[3] = {0.0f, 0.0f, 0.0f};
+      bool m_primed = false;
+  };
+
+}
+
+#endif
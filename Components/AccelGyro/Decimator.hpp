@@ -0,0 +1,212 @@
+// ======================================================================
+// \title  Decimator.hpp
+// \author aidandb
+// \brief  hpp file for the filter and decimation stage between acquisition and telemetry
+// ======================================================================
+
+#ifndef Components_Decimator_HPP
+#define Components_Decimator_HPP
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief filters raw samples and keeps one output for every ratio inputs
+   *
+   * Works on raw counts so the moving average and CIC accumulators are exact integers that never drift, the caller
+   * scales the output once per decimated sample. History lives in a fixed ring and every push does a fixed amount of
+   * work, nothing is allocated.
+   *
+   * \tparam CHANNELS: values per sample, filtered independently
+   * \tparam RING_SIZE: history depth, a power of two, bounds the ratio
+   * \tparam MAX_TAPS: largest FIR the ring has room for
+   */
+  template <FwSizeType CHANNELS, FwSizeType RING_SIZE, FwSizeType MAX_TAPS>
+  class Decimator {
+
+      static_assert((RING_SIZE & (RING_SIZE - 1)) == 0, "ring size must be a power of two");
+      static_assert(MAX_TAPS <= RING_SIZE, "FIR taps must fit in the ring");
+
+    public:
+
+      enum Type {
+        PASS_THROUGH,    //!< every sample is an output, ratio is ignored
+        MOVING_AVERAGE,  //!< mean of the last ratio samples
+        CIC,             //!< CIC_STAGES integrators, decimate by ratio, CIC_STAGES combs
+        FIR              //!< configured taps over the newest samples, evaluated only on output
+      };
+
+      static const U32 CIC_STAGES = 3;
+
+      Decimator()
+      {
+        (void) configure(PASS_THROUGH, 1, nullptr, 0);
+      }
+
+      /**
+       * \brief select the filter and clear all history
+       * \param type: filter to run
+       * \param ratio: inputs per output, 1 to RING_SIZE, ignored for PASS_THROUGH
+       * \param taps: FIR coefficients, newest sample first, only used for FIR
+       * \param numTaps: number of taps, up to MAX_TAPS
+       * \return false and leave the filter unchanged when the settings are out of range
+       */
+      bool configure(Type type, U32 ratio, const F32* taps, FwSizeType numTaps)
+      {
+        if (((type != PASS_THROUGH) && ((ratio == 0) || (ratio > RING_SIZE))) || (numTaps > MAX_TAPS) ||
+            ((type == FIR) && ((taps == nullptr) || (numTaps == 0)))) {
+          return false;
+        }
+
+        this->m_type = type;
+        this->m_ratio = (type == PASS_THROUGH) ? 1 : ratio;
+        this->m_numTaps = (type == FIR) ? numTaps : 0;
+        for (FwSizeType k = 0; k < this->m_numTaps; k++) {
+          this->m_taps[k] = taps[k];
+        }
+
+        // the CIC gain is ratio^stages
+        F32 gain = 1.0f;
+        for (U32 stage = 0; stage < CIC_STAGES; stage++) {
+          gain *= static_cast<F32>(this->m_ratio);
+        }
+        this->m_cicRecipGain = 1.0f / gain;
+
+        reset();
+        return true;
+      }
+
+      /**
+       * \brief clear all history, e.g. after the input scale changes
+       */
+      void reset()
+      {
+        for (FwSizeType slot = 0; slot < RING_SIZE; slot++) {
+          for (FwSizeType c = 0; c < CHANNELS; c++) {
+            this->m_ring[slot][c] = 0;
+          }
+        }
+        for (FwSizeType c = 0; c < CHANNELS; c++) {
+          this->m_sum[c] = 0;
+          this->m_out[c] = 0.0f;
+          for (U32 stage = 0; stage < CIC_STAGES; stage++) {
+            this->m_integrator[stage][c] = 0;
+            this->m_comb[stage][c] = 0;
+          }
+        }
+        this->m_head = 0;
+        this->m_filled = 0;
+        this->m_phase = 0;
+      }
+
+      /**
+       * \brief add one sample
+       * \param sample: CHANNELS raw values
+       * \return true when this sample completes a decimation period and output() holds a new value
+       */
+      bool push(const I16* sample)
+      {
+        FW_ASSERT(sample != nullptr);
+        const FwSizeType slot = this->m_head;
+        this->m_head = (this->m_head + 1) & (RING_SIZE - 1);
+
+        // the moving average drops the sample that falls out of the window as the new one enters
+        const FwSizeType leaving = (slot - this->m_ratio) & (RING_SIZE - 1);
+        for (FwSizeType c = 0; c < CHANNELS; c++) {
+          const I32 x = sample[c];
+          if (this->m_type == MOVING_AVERAGE) {
+            this->m_sum[c] += x - this->m_ring[leaving][c];
+          }
+          else if (this->m_type == CIC) {
+            // unsigned integrators wrap, and the combs undo the wrap exactly
+            this->m_integrator[0][c] += static_cast<U64>(static_cast<I64>(x));
+            for (U32 stage = 1; stage < CIC_STAGES; stage++) {
+              this->m_integrator[stage][c] += this->m_integrator[stage - 1][c];
+            }
+          }
+          this->m_ring[slot][c] = x;
+        }
+        if (this->m_filled < this->m_ratio) {
+          this->m_filled++;
+        }
+
+        this->m_phase++;
+        if (this->m_phase < this->m_ratio) {
+          return false;
+        }
+        this->m_phase = 0;
+
+        for (FwSizeType c = 0; c < CHANNELS; c++) {
+          this->m_out[c] = filterOutput(slot, c);
+        }
+        return true;
+      }
+
+      /**
+       * \brief newest output in raw counts, CHANNELS values
+       */
+      const F32* output() const
+      {
+        return this->m_out;
+      }
+
+      Type type() const
+      {
+        return this->m_type;
+      }
+
+      U32 ratio() const
+      {
+        return this->m_ratio;
+      }
+
+    private:
+
+      F32 filterOutput(FwSizeType newest, FwSizeType c)
+      {
+        switch (this->m_type) {
+          case MOVING_AVERAGE:
+            // until the window fills it averages what it has
+            return static_cast<F32>(this->m_sum[c]) / static_cast<F32>(this->m_filled);
+          case CIC: {
+            U64 y = this->m_integrator[CIC_STAGES - 1][c];
+            for (U32 stage = 0; stage < CIC_STAGES; stage++) {
+              const U64 delayed = this->m_comb[stage][c];
+              this->m_comb[stage][c] = y;
+              y -= delayed;
+            }
+            return static_cast<F32>(static_cast<I64>(y)) * this->m_cicRecipGain;
+          }
+          case FIR: {
+            F32 acc = 0.0f;
+            for (FwSizeType k = 0; k < this->m_numTaps; k++) {
+              acc += this->m_taps[k] * static_cast<F32>(this->m_ring[(newest - k) & (RING_SIZE - 1)][c]);
+            }
+            return acc;
+          }
+          case PASS_THROUGH:
+          default:
+            return static_cast<F32>(this->m_ring[newest][c]);
+        }
+      }
+
+      Type m_type;
+      U32 m_ratio;
+      U32 m_filled;   //!< samples in the moving average window so far
+      U32 m_phase;    //!< inputs since the last output
+      FwSizeType m_head;
+      FwSizeType m_numTaps;
+      F32 m_cicRecipGain;
+      F32 m_taps[MAX_TAPS];
+      I32 m_ring[RING_SIZE][CHANNELS];
+      I32 m_sum[CHANNELS];
+      U64 m_integrator[CIC_STAGES][CHANNELS];
+      U64 m_comb[CIC_STAGES][CHANNELS];
+      F32 m_out[CHANNELS];
+  };
+
+}
+
+#endif
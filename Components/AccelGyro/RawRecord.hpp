@@ -0,0 +1,71 @@
+// ======================================================================
+// \title  RawRecord.hpp
+// \author aidandb
+// \brief  hpp file for the layout of raw sample chunks sent to the recorder
+// ======================================================================
+
+#ifndef Components_RawRecord_HPP
+#define Components_RawRecord_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+namespace RawRecord {
+
+  // A chunk is a header followed by fixed size records, all fields big-endian. Unused records at the end of a
+  // partly filled chunk are zero. Chunks are always CHUNK_SIZE bytes so recordings are a whole number of chunks.
+  // Downlinked batches carry the same header and records after the packet descriptor, with no unused records.
+  //
+  // header:  U16 magic, U16 record count, U32 source component base id, U32 seconds, U32 microseconds
+  // record:  U32 microseconds after the header time, accel x/y/z, gyro x/y/z as I16 counts exactly as read
+  static const U16 MAGIC = 0x4952;
+  static const FwSizeType CHUNK_SIZE = 4096;
+  static const FwSizeType HEADER_SIZE = 16;
+  static const FwSizeType RECORD_SIZE = 16;
+  static const FwSizeType RECORDS_PER_CHUNK = (CHUNK_SIZE - HEADER_SIZE) / RECORD_SIZE;
+
+  static const FwSizeType COUNT_OFFSET = 2;
+  static const FwSizeType SOURCE_OFFSET = 4;
+  static const FwSizeType SECONDS_OFFSET = 8;
+  static const FwSizeType USECONDS_OFFSET = 12;
+  static const FwSizeType AXES_OFFSET = 4;
+  static const FwSizeType AXES_SIZE = 6;
+
+  inline void putU16(U8* data, U16 value)
+  {
+    data[0] = static_cast<U8>(value >> 8);
+    data[1] = static_cast<U8>(value);
+  }
+
+  inline void putU32(U8* data, U32 value)
+  {
+    data[0] = static_cast<U8>(value >> 24);
+    data[1] = static_cast<U8>(value >> 16);
+    data[2] = static_cast<U8>(value >> 8);
+    data[3] = static_cast<U8>(value);
+  }
+
+  inline void putHeader(U8* header, U16 count, U32 source, U64 timeUs)
+  {
+    putU16(header, MAGIC);
+    putU16(&header[COUNT_OFFSET], count);
+    putU32(&header[SOURCE_OFFSET], source);
+    putU32(&header[SECONDS_OFFSET], static_cast<U32>(timeUs / 1000000));
+    putU32(&header[USECONDS_OFFSET], static_cast<U32>(timeUs % 1000000));
+  }
+
+  inline void putRecord(U8* record, U32 offsetUs, const U8* accel, const U8* gyro)
+  {
+    putU32(record, offsetUs);
+    for (FwSizeType i = 0; i < AXES_SIZE; i++) {
+      record[AXES_OFFSET + i] = accel[i];
+      record[AXES_OFFSET + AXES_SIZE + i] = gyro[i];
+    }
+  }
+
+}
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+// ======================================================================
+// \title  RegisterShadow.hpp
+// \author aidandb
+// \brief  hpp file for the copy of the configuration registers the device is known to hold
+// ======================================================================
+
+#ifndef Components_RegisterShadow_HPP
+#define Components_RegisterShadow_HPP
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief what a window of device registers was last written with, and what is still to be written to them
+   *
+   * Only registers that have been tracked are shadowed. A value staged for a register that is known to hold it
+   * already is dropped, anything else is pending until the next flush. Pending registers are handed out as runs of
+   * consecutive addresses so each run goes to the device in one auto-increment burst. A register whose write failed,
+   * or that has never been written, is unknown and the next value staged for it is always written.
+   *
+   * \tparam FIRST: lowest address in the window
+   * \tparam LAST: highest address in the window
+   */
+  template <U8 FIRST, U8 LAST>
+  class RegisterShadow {
+
+      static_assert(FIRST <= LAST, "the window must hold at least one register");
+
+    public:
+
+      static const U8 FIRST_ADDR = FIRST;
+      static const FwSizeType SPAN = static_cast<FwSizeType>(LAST - FIRST) + 1;
+
+      /**
+       * \brief shadow a register, it starts out unknown
+       */
+      void track(U8 addr)
+      {
+        this->m_tracked[index(addr)] = true;
+      }
+
+      bool tracked(U8 addr) const
+      {
+        return (addr >= FIRST) && (addr <= LAST) && this->m_tracked[addr - FIRST];
+      }
+
+      /**
+       * \brief forget everything the device holds, every register is written again the next time it is staged
+       */
+      void invalidate()
+      {
+        for (FwSizeType i = 0; i < SPAN; i++) {
+          this->m_known[i] = false;
+        }
+      }
+
+      /**
+       * \brief ask for a value to be written on the next flush, dropped when the device already holds it
+       */
+      void stage(U8 addr, U8 value)
+      {
+        const FwSizeType i = index(addr);
+        FW_ASSERT(this->m_tracked[i], static_cast<FwAssertArgType>(addr));
+        this->m_staged[i] = value;
+        this->m_pending[i] = !(this->m_known[i] && (this->m_value[i] == value));
+      }
+
+      /**
+       * \brief next run of consecutive pending registers, lowest address first
+       * \param start: set to the address of the first register in the run
+       * \param values: room for SPAN values, filled with the run's staged values
+       * \return registers in the run, 0 when nothing is pending
+       */
+      FwSizeType nextRun(U8& start, U8* values) const
+      {
+        FW_ASSERT(values != nullptr);
+        FwSizeType i = 0;
+        while ((i < SPAN) && !this->m_pending[i]) {
+          i++;
+        }
+        FwSizeType count = 0;
+        for (; ((i + count) < SPAN) && this->m_pending[i + count]; count++) {
+          values[count] = this->m_staged[i + count];
+        }
+        start = static_cast<U8>(FIRST + i);
+        return count;
+      }
+
+      /**
+       * \brief settle a run handed out by nextRun(), the device holds it when it was written, otherwise it is unknown
+       */
+      void written(U8 start, FwSizeType count, bool ok)
+      {
+        for (FwSizeType i = index(start); count > 0; i++, count--) {
+          FW_ASSERT(i < SPAN, static_cast<FwAssertArgType>(i));
+          this->m_known[i] = ok;
+          this->m_value[i] = this->m_staged[i];
+          this->m_pending[i] = false;
+        }
+      }
+
+      /**
+       * \brief true when the device is known to hold a register
+       * \param value: set to the value it holds
+       */
+      bool known(U8 addr, U8& value) const
+      {
+        const FwSizeType i = index(addr);
+        value = this->m_value[i];
+        return this->m_known[i];
+      }
+
+      /**
+       * \brief check a read back of the whole window, known registers that differ are staged again to be repaired
+       * \param block: SPAN bytes read from FIRST
+       * \param addr: set to the first register that differs
+       * \param expected: set to what it should hold
+       * \return number of known registers that differ
+       */
+      FwSizeType verify(const U8* block, U8& addr, U8& expected)
+      {
+        FW_ASSERT(block != nullptr);
+        FwSizeType mismatches = 0;
+        for (FwSizeType i = 0; i < SPAN; i++) {
+          if (!this->m_tracked[i] || !this->m_known[i] || (block[i] == this->m_value[i])) {
+            continue;
+          }
+          if (mismatches == 0) {
+            addr = static_cast<U8>(FIRST + i);
+            expected = this->m_value[i];
+          }
+          mismatches++;
+          this->m_staged[i] = this->m_value[i];
+          this->m_value[i] = block[i];
+          this->m_pending[i] = true;
+        }
+        return mismatches;
+      }
+
+    private:
+
+      static FwSizeType index(U8 addr)
+      {
+        FW_ASSERT((addr >= FIRST) && (addr <= LAST), static_cast<FwAssertArgType>(addr));
+        return static_cast<FwSizeType>(addr - FIRST);
+      }
+
+      bool m_tracked[SPAN] = {};
+      bool m_known[SPAN] = {};
+      bool m_pending[SPAN] = {};
+      U8 m_value[SPAN] = {};
+      U8 m_staged[SPAN] = {};
+  };
+
+}
+
+#endif
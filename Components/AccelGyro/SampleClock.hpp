@@ -0,0 +1,153 @@
+// ======================================================================
+// \title  SampleClock.hpp
+// \author aidandb
+// \brief  hpp file for dating FIFO frames from one clock read per drain
+// ======================================================================
+
+#ifndef Components_SampleClock_HPP
+#define Components_SampleClock_HPP
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief dates every frame of a FIFO drain from the one host time read when it was drained
+   *
+   * The device samples on its own clock, which runs a little fast or slow against the host's. Each drain predicts when
+   * its newest frame was taken from the last one and the frames since, at the tracked sample period. The host time of
+   * the drain then corrects that prediction a little, and the period a great deal less, so read latency jitter is
+   * averaged out while the period follows the device's clock. Frames are dated back from the newest one by the tracked
+   * period, so consecutive drains line up without gaps or overlaps.
+   *
+   * Times are kept in 1/65536 us so the period does not round to whole microseconds, all integer, nothing allocated.
+   */
+  class SampleClock {
+
+    public:
+
+      static const U32 FRACTION_BITS = 16;
+
+      //! Share of a drain's timing error taken into the newest frame's time
+      static const I64 PHASE_GAIN_DIV = 16;
+
+      //! Share of a drain's timing error, per frame, taken into the period
+      static const I64 PERIOD_GAIN_DIV = 4096;
+
+      //! Largest departure of the period from nominal that is believed, a sixteenth
+      static const I64 PERIOD_TOLERANCE_DIV = 16;
+
+      //! Timing error that means frames were lost or the host clock was stepped, the next drain starts over
+      static const I64 RESYNC_US = 100000;
+
+      /**
+       * \brief set the sample period the device was configured with
+       *
+       * A new period also drops the tracked one, the same period keeps it as the ratio between the clocks still holds.
+       * Either way the next drain starts over.
+       */
+      void configure(U32 nominalUs)
+      {
+        FW_ASSERT(nominalUs > 0);
+        const I64 nominal = static_cast<I64>(nominalUs) << FRACTION_BITS;
+        if (nominal != this->m_nominal) {
+          this->m_nominal = nominal;
+          this->m_period = nominal;
+        }
+        restart();
+      }
+
+      /**
+       * \brief the frames that follow are not continuous with the last drain, the next drain is dated from its own read
+       */
+      void restart()
+      {
+        this->m_anchored = false;
+      }
+
+      /**
+       * \brief account for a drain and date its newest frame
+       * \param hostUs: host time read once the drain was read
+       * \param frames: frames in the drain, all of them queued since the last drain
+       */
+      void drain(U64 hostUs, U32 frames)
+      {
+        if (frames == 0) {
+          return;
+        }
+
+        // nothing to predict from yet, and m_newestUs may be 0 against an epoch host time
+        if (!this->m_anchored) {
+          anchor(hostUs);
+          return;
+        }
+
+        // the newest frame follows the last drain's by one period per frame, a host time from before it can only be a
+        // clock step; the miss is checked in whole microseconds first so elapsedUs is bounded before it is shifted
+        const I64 elapsedUs = static_cast<I64>(hostUs - this->m_newestUs);
+        const I64 predicted = this->m_fraction + static_cast<I64>(frames) * this->m_period;
+        const I64 missUs = elapsedUs - (predicted >> FRACTION_BITS);
+        if ((elapsedUs <= 0) || (missUs > RESYNC_US) || (missUs < -RESYNC_US)) {
+          anchor(hostUs);
+          return;
+        }
+        const I64 error = (elapsedUs << FRACTION_BITS) - predicted;
+
+        const I64 newest = predicted + error / PHASE_GAIN_DIV;
+        this->m_period += error / (PERIOD_GAIN_DIV * static_cast<I64>(frames));
+        const I64 tolerance = this->m_nominal / PERIOD_TOLERANCE_DIV;
+        if (this->m_period > this->m_nominal + tolerance) {
+          this->m_period = this->m_nominal + tolerance;
+        }
+        else if (this->m_period < this->m_nominal - tolerance) {
+          this->m_period = this->m_nominal - tolerance;
+        }
+
+        // newest is positive, the newest frame is always after the last drain's
+        this->m_newestUs += static_cast<U64>(newest >> FRACTION_BITS);
+        this->m_fraction = newest & ((static_cast<I64>(1) << FRACTION_BITS) - 1);
+      }
+
+      /**
+       * \brief time of a frame of the last drain, rounded down to the microsecond
+       * \param age: frames before the newest one, 0 for the newest
+       */
+      U64 frameUs(U32 age) const
+      {
+        const I64 back = static_cast<I64>(age) * this->m_period - this->m_fraction;
+        if (back <= 0) {
+          return this->m_newestUs;
+        }
+        const U64 backUs = static_cast<U64>((back + (static_cast<I64>(1) << FRACTION_BITS) - 1) >> FRACTION_BITS);
+        return (this->m_newestUs > backUs) ? (this->m_newestUs - backUs) : 0;
+      }
+
+      /**
+       * \brief tracked period against nominal, in parts per million, positive when the device samples slower
+       */
+      I32 driftPpm() const
+      {
+        return static_cast<I32>(((this->m_period - this->m_nominal) * 1000000) / this->m_nominal);
+      }
+
+    private:
+
+      //! date the newest frame by the host time alone
+      void anchor(U64 hostUs)
+      {
+        this->m_newestUs = hostUs;
+        this->m_fraction = 0;
+        this->m_anchored = true;
+      }
+
+      I64 m_nominal = 0;
+      I64 m_period = 0;
+      U64 m_newestUs = 0;
+      I64 m_fraction = 0;
+      bool m_anchored = false;
+  };
+
+}
+
+#endif
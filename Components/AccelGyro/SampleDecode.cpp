@@ -0,0 +1,160 @@
+// ======================================================================
+// \title  SampleDecode.cpp
+// \author aidandb
+// \brief  cpp file for batch decode of raw MPU-6050 samples
+// ======================================================================
+
+#include "Components/AccelGyro/SampleDecode.hpp"
+
+// vdivq_f32 only exists on AArch64, 32-bit NEON targets use the scalar path
+#if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SAMPLE_DECODE_NEON 1
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define SAMPLE_DECODE_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SAMPLE_DECODE_SSE2 1
+#endif
+
+namespace Components {
+
+namespace SampleDecode {
+
+  static_assert(sizeof(ScaledFrame) == 6 * sizeof(F32), "ScaledFrame must be six packed floats");
+
+  void decodeFramesScalar(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out)
+  {
+    for (FwSizeType i = 0; i < frames; i++) {
+      const U8* const frame = raw + i * FRAME_SIZE_BYTES;
+      for (U32 axis = 0; axis < 3; axis++) {
+        out[i].accel[axis] = scaleAxis(frame + 2 * axis, accelScale);
+        out[i].gyro[axis] = scaleAxis(frame + 6 + 2 * axis, gyroScale);
+      }
+    }
+  }
+
+  // Two frames are 12 axes, which is three 4-lane vectors. The accel/gyro pattern repeats every 12 axes so the
+  // three scale vectors are a a a g, g g a a and a g g g.
+
+#if SAMPLE_DECODE_NEON
+
+  void decodeFrames(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out)
+  {
+    const F32 a = accelScale;
+    const F32 g = gyroScale;
+    const F32 scale0[4] = {a, a, a, g};
+    const F32 scale1[4] = {g, g, a, a};
+    const F32 scale2[4] = {a, g, g, g};
+    const float32x4_t s0 = vld1q_f32(scale0);
+    const float32x4_t s1 = vld1q_f32(scale1);
+    const float32x4_t s2 = vld1q_f32(scale2);
+
+    FwSizeType i = 0;
+    for (; i + 2 <= frames; i += 2) {
+      const U8* const src = raw + i * FRAME_SIZE_BYTES;
+      F32* const dst = reinterpret_cast<F32*>(out + i);
+
+      // swap bytes within each 16-bit lane to go from big-endian to native
+      const int16x8_t v0 = vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(src)));
+      const int16x4_t v1 = vreinterpret_s16_u8(vrev16_u8(vld1_u8(src + 16)));
+
+      vst1q_f32(dst + 0, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v0))), s0));
+      vst1q_f32(dst + 4, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v0))), s1));
+      vst1q_f32(dst + 8, vdivq_f32(vcvtq_f32_s32(vmovl_s16(v1)), s2));
+    }
+    decodeFramesScalar(raw + i * FRAME_SIZE_BYTES, frames - i, accelScale, gyroScale, out + i);
+  }
+
+#elif SAMPLE_DECODE_AVX2
+
+  // Four frames are 24 axes, three 8-lane vectors: a a a g g g a a, a g g g a a a g and g g a a a g g g
+
+  namespace {
+    inline __m128i byteSwap16(__m128i v)
+    {
+      return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+    inline __m256 scale8(__m128i v, __m256 scale)
+    {
+      return _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(byteSwap16(v))), scale);
+    }
+  }
+
+  void decodeFrames(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out)
+  {
+    const F32 a = accelScale;
+    const F32 g = gyroScale;
+    const __m256 s0 = _mm256_setr_ps(a, a, a, g, g, g, a, a);
+    const __m256 s1 = _mm256_setr_ps(a, g, g, g, a, a, a, g);
+    const __m256 s2 = _mm256_setr_ps(g, g, a, a, a, g, g, g);
+
+    FwSizeType i = 0;
+    for (; i + 4 <= frames; i += 4) {
+      const U8* const src = raw + i * FRAME_SIZE_BYTES;
+      F32* const dst = reinterpret_cast<F32*>(out + i);
+
+      _mm256_storeu_ps(dst + 0, scale8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0)), s0));
+      _mm256_storeu_ps(dst + 8, scale8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16)), s1));
+      _mm256_storeu_ps(dst + 16, scale8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32)), s2));
+    }
+    decodeFramesScalar(raw + i * FRAME_SIZE_BYTES, frames - i, accelScale, gyroScale, out + i);
+  }
+
+#elif SAMPLE_DECODE_SSE2
+
+  namespace {
+    inline __m128i byteSwap16(__m128i v)
+    {
+      return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    }
+
+    // interleaving a lane with itself then shifting right by 16 sign-extends it to 32 bits
+    inline __m128 scaleLow(__m128i v, __m128 scale)
+    {
+      return _mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), scale);
+    }
+
+    inline __m128 scaleHigh(__m128i v, __m128 scale)
+    {
+      return _mm_div_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), scale);
+    }
+  }
+
+  void decodeFrames(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out)
+  {
+    const F32 a = accelScale;
+    const F32 g = gyroScale;
+    const __m128 s0 = _mm_setr_ps(a, a, a, g);
+    const __m128 s1 = _mm_setr_ps(g, g, a, a);
+    const __m128 s2 = _mm_setr_ps(a, g, g, g);
+
+    FwSizeType i = 0;
+    for (; i + 2 <= frames; i += 2) {
+      const U8* const src = raw + i * FRAME_SIZE_BYTES;
+      F32* const dst = reinterpret_cast<F32*>(out + i);
+
+      const __m128i v0 = byteSwap16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+      const __m128i v1 = byteSwap16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 16)));
+
+      _mm_storeu_ps(dst + 0, scaleLow(v0, s0));
+      _mm_storeu_ps(dst + 4, scaleHigh(v0, s1));
+      _mm_storeu_ps(dst + 8, scaleLow(v1, s2));
+    }
+    decodeFramesScalar(raw + i * FRAME_SIZE_BYTES, frames - i, accelScale, gyroScale, out + i);
+  }
+
+#else
+
+  void decodeFrames(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out)
+  {
+    decodeFramesScalar(raw, frames, accelScale, gyroScale, out);
+  }
+
+#endif
+
+}
+
+}
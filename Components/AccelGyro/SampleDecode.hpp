@@ -0,0 +1,78 @@
+// ======================================================================
+// \title  SampleDecode.hpp
+// \author aidandb
+// \brief  hpp file for batch decode of raw MPU-6050 samples
+// ======================================================================
+
+#ifndef Components_SampleDecode_HPP
+#define Components_SampleDecode_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+namespace SampleDecode {
+
+  //! Size of one FIFO frame: accel x/y/z then gyro x/y/z, big-endian I16
+  static const FwSizeType FRAME_SIZE_BYTES = 12;
+
+  //! One frame scaled to physical units
+  struct ScaledFrame {
+    F32 accel[3];
+    F32 gyro[3];
+  };
+
+  /**
+   * \brief read one big-endian two's complement axis
+   */
+  inline I16 rawAxis(const U8* data)
+  {
+    return static_cast<I16>((static_cast<U16>(data[0]) << 8) | static_cast<U16>(data[1]));
+  }
+
+  /**
+   * \brief read one axis and divide it by its sensitivity
+   */
+  inline F32 scaleAxis(const U8* data, F32 scaleFactor)
+  {
+    return static_cast<F32>(rawAxis(data)) / scaleFactor;
+  }
+
+  /**
+   * \brief round a filtered value in counts back to the nearest count the device could have produced
+   */
+  inline I16 roundCount(F32 counts)
+  {
+    if (counts >= 32767.0f) {
+      return 32767;
+    }
+    if (counts <= -32768.0f) {
+      return -32768;
+    }
+    return static_cast<I16>((counts >= 0.0f) ? (counts + 0.5f) : (counts - 0.5f));
+  }
+
+  /**
+   * \brief decode interleaved FIFO frames to scaled floats
+   *
+   * Uses NEON, AVX2 or SSE2 when the target has them and scalar code otherwise. Every path divides, which is correctly
+   * rounded, so it produces the same bits as scaleAxis.
+   *
+   * \param raw: frames * FRAME_SIZE_BYTES bytes read from FIFO_R_W
+   * \param frames: number of frames to decode
+   * \param accelScale: accelerometer LSB per g
+   * \param gyroScale: gyroscope LSB per deg/s
+   * \param out: frames entries to fill
+   */
+  void decodeFrames(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out);
+
+  /**
+   * \brief portable reference for decodeFrames
+   */
+  void decodeFramesScalar(const U8* raw, FwSizeType frames, F32 accelScale, F32 gyroScale, ScaledFrame* out);
+
+}
+
+}
+
+#endif
@@ -0,0 +1,183 @@
+// ======================================================================
+// \title  SampleRing.hpp
+// \author aidandb
+// \brief  hpp file for the single-producer multi-consumer ring of decoded samples
+// ======================================================================
+
+#ifndef Components_SampleRing_HPP
+#define Components_SampleRing_HPP
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+
+#include <atomic>
+#include <cstring>
+
+namespace Components {
+
+  //! One decoded sample, accel in g and gyro in deg/s
+  struct RingSample {
+    F32 accel[3];
+    F32 gyro[3];
+    U64 timeUs;
+  };
+
+  /**
+   * \brief fixed ring of decoded samples written by one thread and read by any number of readers at their own pace
+   *
+   * The writer never waits: it overwrites the oldest slot whatever the readers have got to, so a slow reader loses
+   * samples rather than holding up acquisition. Samples are written once, into the ring, however many readers there
+   * are. A batch of samples becomes visible with a single release of the head, so a reader sees all of it or none.
+   *
+   * Each Reader keeps its own cursor and overrun count and copies out under a sequence check: the writer announces
+   * the slots it is about to overwrite before touching them, and a reader drops anything it copied from a slot that
+   * was announced while it was copying. Nothing locks and nothing is allocated.
+   *
+   * \tparam CAPACITY: samples held, a power of two
+   */
+  template <FwSizeType CAPACITY>
+  class SampleRing {
+
+      static_assert((CAPACITY > 0) && ((CAPACITY & (CAPACITY - 1)) == 0), "ring capacity must be a power of two");
+
+    public:
+
+      /**
+       * \brief cursor into the ring owned by one consumer, only ever used from one thread
+       */
+      class Reader {
+
+        public:
+
+          /**
+           * \brief attach to a ring, the first read returns samples written after this
+           */
+          explicit Reader(const SampleRing& ring) :
+              m_ring(ring),
+              m_cursor(ring.m_head.load(std::memory_order_acquire))
+          {
+          }
+
+          /**
+           * \brief copy out the oldest unread samples
+           * \param out: room for max samples
+           * \param max: most samples to return
+           * \return number of samples copied, oldest first
+           */
+          FwSizeType read(RingSample* out, FwSizeType max)
+          {
+            FW_ASSERT(out != nullptr);
+            const U64 head = this->m_ring.m_head.load(std::memory_order_acquire);
+            U64 cursor = this->m_cursor;
+
+            // lapped, everything older than one ring behind the head is gone
+            if ((head - cursor) > CAPACITY) {
+              this->m_overruns += head - CAPACITY - cursor;
+              cursor = head - CAPACITY;
+            }
+            const U64 pending = head - cursor;
+            const FwSizeType count = (pending < max) ? static_cast<FwSizeType>(pending) : max;
+            for (FwSizeType i = 0; i < count; i++) {
+              out[i] = this->m_ring.m_slots[(cursor + i) & MASK];
+            }
+
+            // any slot the writer announced since the copy began may be torn, drop it and everything before it
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const U64 reserved = this->m_ring.m_reserved.load(std::memory_order_relaxed);
+            FwSizeType dropped = 0;
+            if ((reserved > CAPACITY) && (cursor < reserved - CAPACITY)) {
+              const U64 stale = reserved - CAPACITY - cursor;
+              dropped = (stale < count) ? static_cast<FwSizeType>(stale) : count;
+              this->m_overruns += dropped;
+              (void) memmove(out, &out[dropped], (count - dropped) * sizeof(RingSample));
+            }
+            this->m_cursor = cursor + count;
+            return count - dropped;
+          }
+
+          //! Samples written that this reader has not read yet, lost ones included
+          U64 available() const
+          {
+            return this->m_ring.m_head.load(std::memory_order_acquire) - this->m_cursor;
+          }
+
+          //! Samples this reader lost to the writer lapping it
+          U64 overruns() const
+          {
+            return this->m_overruns;
+          }
+
+        private:
+
+          const SampleRing& m_ring;
+          U64 m_cursor;
+          U64 m_overruns = 0;
+      };
+
+      static const FwSizeType SIZE = CAPACITY;
+
+      SampleRing() = default;
+      SampleRing(const SampleRing&) = delete;
+      SampleRing& operator=(const SampleRing&) = delete;
+
+      /**
+       * \brief announce the next count samples, readers still looking at the slots they overwrite will drop them
+       */
+      void begin(FwSizeType count)
+      {
+        FW_ASSERT(count <= CAPACITY, static_cast<FwAssertArgType>(count));
+        FW_ASSERT(this->m_staged == 0, static_cast<FwAssertArgType>(this->m_staged));
+        this->m_batch = count;
+        this->m_reserved.store(this->m_head.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+      }
+
+      /**
+       * \brief write the next announced sample, readers do not see it until commit()
+       */
+      void put(const F32* accel, const F32* gyro, U64 timeUs)
+      {
+        FW_ASSERT(this->m_staged < this->m_batch, static_cast<FwAssertArgType>(this->m_staged));
+        RingSample& slot = this->m_slots[(this->m_head.load(std::memory_order_relaxed) + this->m_staged) & MASK];
+        slot.accel[0] = accel[0];
+        slot.accel[1] = accel[1];
+        slot.accel[2] = accel[2];
+        slot.gyro[0] = gyro[0];
+        slot.gyro[1] = gyro[1];
+        slot.gyro[2] = gyro[2];
+        slot.timeUs = timeUs;
+        this->m_staged++;
+      }
+
+      /**
+       * \brief make every sample put since begin() visible at once
+       */
+      void commit()
+      {
+        const U64 head = this->m_head.load(std::memory_order_relaxed) + this->m_staged;
+        this->m_staged = 0;
+        this->m_batch = 0;
+        this->m_head.store(head, std::memory_order_release);
+      }
+
+      //! Samples written since startup
+      U64 written() const
+      {
+        return this->m_head.load(std::memory_order_acquire);
+      }
+
+    private:
+
+      static const U64 MASK = CAPACITY - 1;
+
+      // the counters readers poll sit on their own cache line, apart from the slots being written
+      alignas(64) std::atomic<U64> m_head{0};
+      std::atomic<U64> m_reserved{0};
+      FwSizeType m_batch = 0;
+      FwSizeType m_staged = 0;
+      alignas(64) RingSample m_slots[CAPACITY];
+  };
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+// ======================================================================
+// \title  StageProfiler.hpp
+// \author aidandb
+// \brief  hpp file for the per-stage latency histograms of the acquisition path
+// ======================================================================
+
+#ifndef Components_StageProfiler_HPP
+#define Components_StageProfiler_HPP
+
+#include <Fw/Types/Assert.hpp>
+#include <Fw/Types/BasicTypes.hpp>
+
+// set to 0 by the ACCELGYRO_STAGE_PROFILING cmake option to take every clock read out of the acquisition path
+#ifndef ACCELGYRO_STAGE_PROFILING
+#define ACCELGYRO_STAGE_PROFILING 1
+#endif
+
+#if ACCELGYRO_STAGE_PROFILING == 1
+#include <chrono>
+#endif
+
+namespace Components {
+
+  /**
+   * \brief times the stages of a tick and keeps a log-scale histogram, maximum and count for each
+   *
+   * A tick is opened with start() and every mark() charges the time since the previous stamp to a stage, so one clock
+   * read closes a stage and opens the next. A stage marked more than once in a tick is summed. finish() adds each stage
+   * that was marked, and the whole tick, to the histograms. Bucket 0 holds anything under 128 ns, each bucket after it
+   * is twice as wide and the last is open ended. Nothing is allocated and recording is a handful of integer operations.
+   *
+   * Built with ACCELGYRO_STAGE_PROFILING set to 0 every call is an empty inline and reads report zero.
+   *
+   * \tparam STAGES: stages timed, the last one is the whole tick
+   */
+  template <FwSizeType STAGES>
+  class StageProfiler {
+
+      static_assert((STAGES > 1) && (STAGES <= 32), "stages are tracked in a 32 bit mask, the last one is the tick");
+
+    public:
+
+      static const FwSizeType NUM_BUCKETS = 16;
+      static const U32 FIRST_BUCKET_SHIFT = 7;
+      static const FwSizeType TICK = STAGES - 1;
+      static const bool ENABLED = (ACCELGYRO_STAGE_PROFILING == 1);
+
+      /**
+       * \brief bucket a latency falls in
+       */
+      static FwSizeType bucket(U32 ns)
+      {
+        if (ns < (1u << FIRST_BUCKET_SHIFT)) {
+          return 0;
+        }
+        U32 log2 = 0;
+#if defined(__GNUC__)
+        log2 = 31 - static_cast<U32>(__builtin_clz(ns));
+#else
+        for (U32 v = ns; v > 1; v >>= 1) {
+          log2++;
+        }
+#endif
+        const FwSizeType index = log2 - FIRST_BUCKET_SHIFT + 1;
+        return (index < NUM_BUCKETS) ? index : NUM_BUCKETS - 1;
+      }
+
+      /**
+       * \brief longest latency a bucket holds, the open ended last bucket reports the maximum
+       */
+      static U32 bucketLimit(FwSizeType index)
+      {
+        FW_ASSERT(index < NUM_BUCKETS, static_cast<FwAssertArgType>(index));
+        return (index == NUM_BUCKETS - 1) ? 0xFFFFFFFFu : (1u << (index + FIRST_BUCKET_SHIFT)) - 1;
+      }
+
+#if ACCELGYRO_STAGE_PROFILING == 1
+
+      StageProfiler()
+      {
+        reset();
+      }
+
+      /**
+       * \brief clear every histogram
+       */
+      void reset()
+      {
+        for (FwSizeType s = 0; s < STAGES; s++) {
+          this->m_count[s] = 0;
+          this->m_max[s] = 0;
+          for (FwSizeType b = 0; b < NUM_BUCKETS; b++) {
+            this->m_buckets[s][b] = 0;
+          }
+        }
+        this->m_running = false;
+      }
+
+      /**
+       * \brief open a tick, anything marked in the last tick but not finished is dropped
+       */
+      void start()
+      {
+        this->m_startNs = now();
+        this->m_lastNs = this->m_startNs;
+        this->m_marked = 0;
+        this->m_running = true;
+      }
+
+      /**
+       * \brief charge the time since the last stamp to a stage
+       */
+      void mark(FwSizeType stage)
+      {
+        FW_ASSERT(stage < TICK, static_cast<FwAssertArgType>(stage));
+        if (!this->m_running) {
+          return;
+        }
+        const U64 nowNs = now();
+        const U64 elapsed = nowNs - this->m_lastNs;
+        this->m_lastNs = nowNs;
+        this->m_tickNs[stage] = ((this->m_marked & (1u << stage)) != 0) ? this->m_tickNs[stage] + elapsed : elapsed;
+        this->m_marked |= (1u << stage);
+      }
+
+      /**
+       * \brief close the tick at the last mark and add its stages to the histograms
+       */
+      void finish()
+      {
+        if (!this->m_running) {
+          return;
+        }
+        for (FwSizeType s = 0; s < TICK; s++) {
+          if ((this->m_marked & (1u << s)) != 0) {
+            record(s, this->m_tickNs[s]);
+          }
+        }
+        record(TICK, this->m_lastNs - this->m_startNs);
+        this->m_running = false;
+      }
+
+      /**
+       * \brief add one latency to a stage
+       */
+      void record(FwSizeType stage, U64 ns)
+      {
+        FW_ASSERT(stage < STAGES, static_cast<FwAssertArgType>(stage));
+        const U32 clamped = (ns > 0xFFFFFFFFu) ? 0xFFFFFFFFu : static_cast<U32>(ns);
+        this->m_buckets[stage][bucket(clamped)]++;
+        this->m_count[stage]++;
+        if (clamped > this->m_max[stage]) {
+          this->m_max[stage] = clamped;
+        }
+      }
+
+      U32 count(FwSizeType stage) const
+      {
+        FW_ASSERT(stage < STAGES, static_cast<FwAssertArgType>(stage));
+        return this->m_count[stage];
+      }
+
+      U32 maxNs(FwSizeType stage) const
+      {
+        FW_ASSERT(stage < STAGES, static_cast<FwAssertArgType>(stage));
+        return this->m_max[stage];
+      }
+
+      const U32* buckets(FwSizeType stage) const
+      {
+        FW_ASSERT(stage < STAGES, static_cast<FwAssertArgType>(stage));
+        return this->m_buckets[stage];
+      }
+
+      /**
+       * \brief upper edge of the bucket holding the 99th percentile, no more than the maximum
+       */
+      U32 p99Ns(FwSizeType stage) const
+      {
+        FW_ASSERT(stage < STAGES, static_cast<FwAssertArgType>(stage));
+        const U32 total = this->m_count[stage];
+        if (total == 0) {
+          return 0;
+        }
+        // rank of the 99th percentile, rounded up so it is never below the true one
+        const U64 rank = (static_cast<U64>(total) * 99 + 99) / 100;
+        U64 seen = 0;
+        FwSizeType b = 0;
+        for (; b < NUM_BUCKETS - 1; b++) {
+          seen += this->m_buckets[stage][b];
+          if (seen >= rank) {
+            break;
+          }
+        }
+        const U32 limit = bucketLimit(b);
+        return (limit < this->m_max[stage]) ? limit : this->m_max[stage];
+      }
+
+    private:
+
+      static U64 now()
+      {
+        return static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count());
+      }
+
+      U32 m_buckets[STAGES][NUM_BUCKETS];
+      U32 m_count[STAGES];
+      U32 m_max[STAGES];
+      U64 m_tickNs[STAGES];
+      U64 m_startNs = 0;
+      U64 m_lastNs = 0;
+      U32 m_marked = 0;
+      bool m_running = false;
+
+#else
+
+      void reset() {}
+      void start() {}
+      void mark(FwSizeType) {}
+      void finish() {}
+      void record(FwSizeType, U64) {}
+      U32 count(FwSizeType) const { return 0; }
+      U32 maxNs(FwSizeType) const { return 0; }
+      U32 p99Ns(FwSizeType) const { return 0; }
+      const U32* buckets(FwSizeType) const { return nullptr; }
+
+#endif
+  };
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+// ======================================================================
+// \title  ActiveAccelGyroTestMain.cpp
+// \author aidandb
+// \brief  cpp file for ActiveAccelGyro component test main function
+// ======================================================================
+
+#include "ActiveAccelGyroTester.hpp"
+
+TEST(Nominal, asyncPower) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testAsyncPower();
+}
+
+TEST(Nominal, deferredParams) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testDeferredParams();
+}
+
+TEST(Error, wakeupOverflow) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testWakeupOverflow();
+}
+
+TEST(DataReady, edge) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testDataReady();
+}
+
+TEST(Error, stalledBus) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testStalledBus();
+}
+
+TEST(Error, queueFull) {
+  Components::ActiveAccelGyroTester tester;
+  tester.testQueueFull();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
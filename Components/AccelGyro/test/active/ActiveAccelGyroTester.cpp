@@ -0,0 +1,392 @@
+// ======================================================================
+// \title  ActiveAccelGyroTester.cpp
+// \author aidandb
+// \brief  cpp file for ActiveAccelGyro component test harness implementation class
+// ======================================================================
+
+#include "ActiveAccelGyroTester.hpp"
+
+#include <cstring>
+#include <thread>
+
+#define ADDRESS_TEST Components::ActiveAccelGyro::I2cAddr::AD0_0
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ActiveAccelGyroTester ::
+    ActiveAccelGyroTester() :
+      ActiveAccelGyroGTestBase("ActiveAccelGyroTester", ActiveAccelGyroTester::MAX_HISTORY_SIZE),
+      component("ActiveAccelGyro"),
+      m_stallBus(false),
+      m_busStalled(false)
+  {
+    memset(this->writtenRegs, 0, sizeof this->writtenRegs);
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+    this->component.setup(ADDRESS_TEST);
+  }
+
+  ActiveAccelGyroTester ::
+    ~ActiveAccelGyroTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyroTester ::
+    testAsyncPower()
+  {
+    const U8 poweredOn = ActiveAccelGyro::POWER_ON;
+    const U8 poweredOff = ActiveAccelGyro::POWER_OFF;
+
+    // the command is only taken, nothing goes to the device on the dispatcher's thread and nothing is queued
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_from_write_SIZE(0);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+
+    // power and configuration go out on the component's thread, ahead of the next tick's read
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_GT(this->fromPortHistory_write->size(), 0);
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::POWER_MGMT_ADDR], poweredOn);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, ActiveAccelGyro::OPCODE_POWER_ON_OFF, 0, Fw::CmdResponse::OK);
+    ASSERT_TLM_accelerometer_SIZE(1);
+    this->clearHistory();
+    this->clearFromPortHistory();
+
+    // a wake-up from the rate group only posts a message, the sample is read when it is dispatched
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_writeRead_SIZE(0);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_TLM_accelerometer_SIZE(1);
+
+    // a second command while the first still waits is answered BUSY at once
+    this->sendCmd_POWER_ON_OFF(0, 1, Fw::On::OFF);
+    this->sendCmd_POWER_ON_OFF(0, 2, Fw::On::ON);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, ActiveAccelGyro::OPCODE_POWER_ON_OFF, 2, Fw::CmdResponse::BUSY);
+
+    // power off runs ahead of the tick, so that tick reads nothing
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::POWER_MGMT_ADDR], poweredOff);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(1, ActiveAccelGyro::OPCODE_POWER_ON_OFF, 1, Fw::CmdResponse::OK);
+
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(1);
+  }
+
+
+  void ActiveAccelGyroTester ::
+    testDeferredParams()
+  {
+    this->powerOn();
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::ACCEL_CONFIG_ADDR], 0x00);
+
+    // a parameter is set on the dispatcher's thread, the device is left alone until the next tick
+    this->paramSet_ACCEL_RANGE(Components::AccelRange::G8, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_RANGE(0, 0);
+    ASSERT_from_write_SIZE(0);
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::ACCEL_CONFIG_ADDR], 0x00);
+
+    // the tick applies it before reading the sample
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::ACCEL_CONFIG_ADDR], 0x10);
+    ASSERT_from_write_SIZE(1);
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_TLM_accelRange_SIZE(1);
+    ASSERT_TLM_accelRange(0, Components::AccelRange::G8);
+
+    // and only once
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_write_SIZE(0);
+    ASSERT_from_writeRead_SIZE(1);
+  }
+
+
+  void ActiveAccelGyroTester ::
+    testWakeupOverflow()
+  {
+    this->powerOn();
+
+    // the rate group is never held up, a tick that finds the last wake-up still queued is dropped and counted
+    for (U32 i = 0; i < 4; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_TLM_acquisitionOverruns_SIZE(0);
+
+    // the queued tick reports them and samples
+    this->dispatchOne();
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns(0, 3);
+    ASSERT_from_writeRead_SIZE(1);
+
+    // once it is taken the next tick is queued again
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(2);
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+  }
+
+
+  void ActiveAccelGyroTester ::
+    testDataReady()
+  {
+    const U8 dataReadyEnable = ActiveAccelGyro::INT_ENABLE_DATA_RDY;
+
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::DATA_READY);
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    this->clearHistory();
+    this->powerOn();
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::INT_ENABLE_ADDR], dataReadyEnable);
+
+    // an edge is queued like a wake-up, a parameter set before it is applied before its sample is read
+    this->paramSet_ACCEL_RANGE(Components::AccelRange::G8, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_RANGE(0, 0);
+    this->invoke_to_dataReady(0, 1000);
+    ASSERT_from_writeRead_SIZE(0);
+    this->dispatchOne();
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::ACCEL_CONFIG_ADDR], 0x10);
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_TLM_accelerometer_SIZE(1);
+
+    // the tick has nothing to read
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(1);
+
+    // an edge that finds the last one still queued is counted with the dropped wake-ups
+    this->invoke_to_dataReady(0, 2000);
+    this->invoke_to_dataReady(0, 2001);
+    this->dispatchOne();
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns(0, 1);
+    ASSERT_from_writeRead_SIZE(2);
+
+    // the dropped edge leaves nothing behind, the next edge reads as usual
+    this->invoke_to_dataReady(0, 3000);
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(3);
+    ASSERT_TLM_accelerometer_SIZE(3);
+  }
+
+
+  void ActiveAccelGyroTester ::
+    testStalledBus()
+  {
+    this->powerOn();
+
+    this->paramSet_ACCEL_RANGE(Components::AccelRange::G8, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_RANGE(0, 0);
+    this->invoke_to_Run(0, 0);
+    {
+      std::lock_guard<std::mutex> lock(this->m_busMutex);
+      this->m_stallBus = true;
+    }
+
+    // the component thread takes the wake-up, applies the range and hangs in the write
+    std::thread worker([this]() { this->dispatchOne(); });
+    {
+      std::unique_lock<std::mutex> lock(this->m_busMutex);
+      this->m_busCond.wait(lock, [this]() { return this->m_busStalled; });
+    }
+
+    // the rate group's ticks and the ground's commands come back while the write is still held, the first tick is
+    // queued and the rest only counted
+    for (U32 i = 0; i < 5; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    this->sendCmd_RESET_ERROR_THROTTLE(0, 1);
+    ASSERT_CMD_RESPONSE_SIZE(0);
+    {
+      std::lock_guard<std::mutex> lock(this->m_busMutex);
+      EXPECT_TRUE(this->m_stallBus);
+      this->m_stallBus = false;
+    }
+    this->m_busCond.notify_all();
+
+    // the held wake-up finishes the range, then takes the command and the count before it samples
+    worker.join();
+    ASSERT_EQ(this->writtenRegs[ActiveAccelGyro::ACCEL_CONFIG_ADDR], 0x10);
+    ASSERT_TLM_accelRange_SIZE(1);
+    ASSERT_TLM_accelRange(0, Components::AccelRange::G8);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, ActiveAccelGyro::OPCODE_RESET_ERROR_THROTTLE, 1, Fw::CmdResponse::OK);
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns(0, 4);
+    ASSERT_from_writeRead_SIZE(1);
+
+    // and the tick queued behind it samples again
+    this->dispatchOne();
+    ASSERT_from_writeRead_SIZE(2);
+  }
+
+
+  void ActiveAccelGyroTester ::
+    testQueueFull()
+  {
+    // the queue has exactly the room the component needs, any message past it would assert
+    this->connectBusManager();
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_jobOut_SIZE(1);
+    this->clearHistory();
+
+    // with the read in flight and the thread not running, every source keeps coming
+    for (U32 i = 0; i < 20; i++) {
+      this->invoke_to_Run(0, 0);
+      this->invoke_to_dataReady(0, 1000 + i);
+      this->invoke_to_latencyRun(0, 0);
+    }
+    this->sendCmd_RESET_LATENCY(0, 1);
+    this->sendCmd_RESET_ERROR_THROTTLE(0, 2);
+    ASSERT_CMD_RESPONSE_SIZE(1);
+    ASSERT_CMD_RESPONSE(0, ActiveAccelGyro::OPCODE_RESET_ERROR_THROTTLE, 2, Fw::CmdResponse::BUSY);
+
+    // the completion of the read in flight still finds room
+    Fw::Buffer writeBuffer(this->fromPortHistory_jobOut->at(0).writeBuffer);
+    Fw::Buffer readBuffer(this->fromPortHistory_jobOut->at(0).readBuffer);
+    ASSERT_EQ(this->from_writeRead_handler(0, ADDRESS_TEST, writeBuffer, readBuffer), Drv::I2cStatus::I2C_OK);
+    this->invoke_to_jobDone(0, this->fromPortHistory_jobOut->at(0).context, Drv::I2cStatus::I2C_OK, readBuffer);
+
+    // wake-up, edge, latency report and completion, in the order they were queued
+    this->dispatchOne();
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(1, ActiveAccelGyro::OPCODE_RESET_LATENCY, 1, Fw::CmdResponse::OK);
+    ASSERT_TLM_acquisitionOverruns_SIZE(2);
+    ASSERT_TLM_acquisitionOverruns(0, 38);
+    ASSERT_TLM_acquisitionOverruns(1, 39);
+    this->dispatchOne();
+    this->dispatchOne();
+    ASSERT_TLM_accelerometer_SIZE(0);
+    this->dispatchOne();
+    ASSERT_TLM_accelerometer_SIZE(1);
+
+    // and the next tick queues the next read
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_from_jobOut_SIZE(2);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void ActiveAccelGyroTester ::
+    dispatchOne()
+  {
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+  }
+
+  void ActiveAccelGyroTester ::
+    powerOn()
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->invoke_to_Run(0, 0);
+    this->dispatchOne();
+    ASSERT_CMD_RESPONSE(0, ActiveAccelGyro::OPCODE_POWER_ON_OFF, 0, Fw::CmdResponse::OK);
+    this->clearHistory();
+    this->clearFromPortHistory();
+  }
+
+  void ActiveAccelGyroTester ::
+    connectBusManager()
+  {
+    this->component.set_jobOut_OutputPort(0, this->get_from_jobOut(0));
+  }
+
+  void ActiveAccelGyroTester ::
+    connectPorts()
+  {
+    this->connect_to_Run(0, this->component.get_Run_InputPort(0));
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+    this->connect_to_jobDone(0, this->component.get_jobDone_InputPort(0));
+    this->connect_to_latencyRun(0, this->component.get_latencyRun_InputPort(0));
+    this->connect_to_dataReady(0, this->component.get_dataReady_InputPort(0));
+
+    // jobOut is left unconnected, the component thread does its own reads
+    this->component.set_writeRead_OutputPort(0, this->get_from_writeRead(0));
+    this->component.set_write_OutputPort(0, this->get_from_write(0));
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+#if FW_ENABLE_TEXT_LOGGING == 1
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+#endif
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+    this->component.set_prmGetOut_OutputPort(0, this->get_from_prmGetOut(0));
+    this->component.set_prmSetOut_OutputPort(0, this->get_from_prmSetOut(0));
+  }
+
+  void ActiveAccelGyroTester ::
+    initComponents()
+  {
+    this->init();
+    this->component.init(ActiveAccelGyroTester::TEST_INSTANCE_QUEUE_DEPTH, ActiveAccelGyroTester::TEST_INSTANCE_ID);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Drv::I2cStatus ActiveAccelGyroTester::
+    from_writeRead_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& writeBuffer, Fw::Buffer& readBuffer)
+  {
+    this->pushFromPortEntry_writeRead(addr, writeBuffer, readBuffer);
+    EXPECT_EQ(addr, ADDRESS_TEST);
+    EXPECT_EQ(writeBuffer.getSize(), 1);
+
+    // configuration reads back as written, every other register as the same byte, a level device
+    const U8 pointer = writeBuffer.getData()[0];
+    if (pointer == ActiveAccelGyro::ConfigShadow::FIRST_ADDR) {
+      memcpy(readBuffer.getData(), &this->writtenRegs[pointer], readBuffer.getSize());
+    }
+    else {
+      memset(readBuffer.getData(), 0x10, readBuffer.getSize());
+    }
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  Drv::I2cStatus ActiveAccelGyroTester::
+    from_write_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& serBuffer)
+  {
+    this->pushFromPortEntry_write(addr, serBuffer);
+    EXPECT_EQ(addr, ADDRESS_TEST);
+
+    {
+      std::unique_lock<std::mutex> lock(this->m_busMutex);
+      if (this->m_stallBus) {
+        this->m_busStalled = true;
+        this->m_busCond.notify_all();
+        this->m_busCond.wait(lock, [this]() { return !this->m_stallBus; });
+      }
+    }
+
+    // register pointer first, the device auto-increments through the rest
+    const U8* const data = serBuffer.getData();
+    for (U32 i = 1; (i < serBuffer.getSize()) && ((data[0] + i - 1) < NUM_REGISTERS); i++) {
+      this->writtenRegs[data[0] + i - 1] = data[i];
+    }
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+}
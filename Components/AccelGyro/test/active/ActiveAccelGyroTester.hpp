@@ -0,0 +1,132 @@
+// ======================================================================
+// \title  ActiveAccelGyroTester.hpp
+// \author aidandb
+// \brief  hpp file for ActiveAccelGyro component test harness implementation class
+// ======================================================================
+
+#ifndef Components_ActiveAccelGyroTester_HPP
+#define Components_ActiveAccelGyroTester_HPP
+
+#include "Components/AccelGyro/ActiveAccelGyroGTestBase.hpp"
+#include "Components/AccelGyro/ActiveAccelGyro.hpp"
+#include <condition_variable>
+#include <mutex>
+
+namespace Components {
+
+  class ActiveAccelGyroTester :
+    public ActiveAccelGyroGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test, the least the component accepts
+      static const NATIVE_INT_TYPE TEST_INSTANCE_QUEUE_DEPTH = ActiveAccelGyro::ACQUISITION_MESSAGES;
+
+      // Number of device registers tracked by the write handler
+      static constexpr U16 NUM_REGISTERS = 128;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ActiveAccelGyroTester
+      ActiveAccelGyroTester();
+
+      //! Destroy object ActiveAccelGyroTester
+      ~ActiveAccelGyroTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testAsyncPower();
+
+      void testDeferredParams();
+
+      void testWakeupOverflow();
+
+      void testDataReady();
+
+      void testStalledBus();
+
+      void testQueueFull();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handler for typed from ports
+      // ----------------------------------------------------------------------
+
+      // Handler for from_writeRead
+      Drv::I2cStatus from_writeRead_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                             U32 addr,                         // I2c slave device address
+                                             Fw::Buffer& writeBuffer,          // Buffer with the register pointer
+                                             Fw::Buffer& readBuffer            // Buffer to read into
+      );
+
+      // Handler for from_write
+      Drv::I2cStatus from_write_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                        U32 addr,                         // I2c slave device address
+                                        Fw::Buffer& serBuffer             // Buffer with data to write
+      );
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Dispatch one queued message
+      void dispatchOne();
+
+      //! Power on through a command and the wake-up that runs it, then clear the histories
+      void powerOn();
+
+      //! Connect jobOut so the sample reads go out as jobs
+      void connectBusManager();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ActiveAccelGyro component;
+
+      // last value written to each register
+      U8 writtenRegs[NUM_REGISTERS];
+
+      // while set, a write blocks until it is cleared, like a bus held low by a device
+      bool m_stallBus;
+      // set once a write is blocked on the stalled bus
+      bool m_busStalled;
+      std::mutex m_busMutex;
+      std::condition_variable m_busCond;
+
+  };
+
+}
+
+#endif
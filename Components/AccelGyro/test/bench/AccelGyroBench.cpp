@@ -0,0 +1,416 @@
+// ======================================================================
+// \title  AccelGyroBench.cpp
+// \author aidandb
+// \brief  cpp file for AccelGyro hot path micro-benchmark harness
+// ======================================================================
+
+#include "AccelGyroBench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#define INSTANCE 0
+#define ADDRESS_TEST Components::AccelGyro::I2cAddr::AD0_0
+
+// ----------------------------------------------------------------------
+// Allocation counting
+// ----------------------------------------------------------------------
+
+namespace {
+  std::atomic<U64> g_allocations(0);
+
+  // keeps the optimizer from discarding decoded values
+  volatile F32 g_sink = 0.0f;
+
+  U64 nowNs()
+  {
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+  }
+}
+
+void* operator new(std::size_t size)
+{
+  g_allocations++;
+  void* const memory = std::malloc(size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  AccelGyroBench ::
+    AccelGyroBench() :
+      AccelGyroTesterBase("AccelGyroBench", AccelGyroBench::MAX_HISTORY_SIZE),
+      component("AccelGyro"),
+      addrBuf(0),
+      m_fifoCount(0),
+      m_reads(0),
+      m_writes(0)
+  {
+    memset(this->m_regs, 0, sizeof this->m_regs);
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+    this->component.setup(ADDRESS_TEST);
+  }
+
+  AccelGyroBench ::
+    ~AccelGyroBench()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Benchmarks
+  // ----------------------------------------------------------------------
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchDeserializeVector(U32 iterations)
+  {
+    const U8 data[AccelGyro::MAX_DATA_SIZE] = {0x12, 0x34, 0xF0, 0x0D, 0x40, 0x00};
+
+    this->resetCounters();
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < iterations; i++) {
+      F32x3 vect = this->component.deserializeVector(data, AccelGyro::accelScaleFactor);
+      g_sink = vect[0];
+    }
+    const U64 elapsed = nowNs() - start;
+
+    Result result = {"deserializeVector", iterations, iterations, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / iterations;
+    result.allocsPerSample = static_cast<F64>(g_allocations - allocations) / iterations;
+    return result;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchDecodeFrames(U32 iterations, bool scalar)
+  {
+    U8 raw[AccelGyro::FIFO_MAX_FRAMES * AccelGyro::FIFO_FRAME_SIZE];
+    for (U32 i = 0; i < sizeof raw; i++) {
+      raw[i] = static_cast<U8>(i * 37);
+    }
+    SampleDecode::ScaledFrame frames[AccelGyro::FIFO_MAX_FRAMES];
+    const U32 count = AccelGyro::FIFO_MAX_FRAMES;
+
+    this->resetCounters();
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < iterations; i++) {
+      if (scalar) {
+        SampleDecode::decodeFramesScalar(raw, count, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor, frames);
+      }
+      else {
+        SampleDecode::decodeFrames(raw, count, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor, frames);
+      }
+      g_sink = frames[i % count].gyro[2];
+    }
+    const U64 elapsed = nowNs() - start;
+
+    const U64 samples = static_cast<U64>(iterations) * count;
+    Result result = {scalar ? "decodeFrames.scalar" : "decodeFrames", iterations, samples, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / samples;
+    result.allocsPerSample = static_cast<F64>(g_allocations - allocations) / samples;
+    return result;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchReadRegisterBlock(U32 iterations)
+  {
+    U8 data[AccelGyro::MAX_DATA_SIZE];
+
+    this->resetCounters();
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < iterations; i++) {
+      Fw::Buffer buffer(data, sizeof data);
+      (void) this->component.readRegisterBlock(AccelGyro::SAMPLE_DATA_START, buffer);
+    }
+    const U64 elapsed = nowNs() - start;
+
+    Result result = {"readRegisterBlock", iterations, iterations, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / iterations;
+    result.allocsPerSample = static_cast<F64>(g_allocations - allocations) / iterations;
+    result.readsPerTick = static_cast<F64>(m_reads) / iterations;
+    result.writesPerTick = static_cast<F64>(m_writes) / iterations;
+    return result;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchStageProfiler(U32 iterations)
+  {
+    AccelGyro::TickProfiler profiler;
+
+    // the stage marks of a register tick with nothing in between, what profiling adds to every tick
+    this->resetCounters();
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < iterations; i++) {
+      profiler.start();
+      profiler.mark(AccelGyro::STAGE_BUS);
+      profiler.mark(AccelGyro::STAGE_DECODE);
+      profiler.mark(AccelGyro::STAGE_PUBLISH);
+      profiler.finish();
+    }
+    const U64 elapsed = nowNs() - start;
+    g_sink = static_cast<F32>(profiler.p99Ns(AccelGyro::STAGE_TICK));
+
+    Result result = {"stageProfiler.tick", iterations, iterations, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / iterations;
+    result.allocsPerSample = static_cast<F64>(g_allocations - allocations) / iterations;
+    return result;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchSampleRing(U32 iterations)
+  {
+    static AccelGyro::ImuSampleRing ring;
+    AccelGyro::ImuSampleRing::Reader reader(ring);
+    SampleDecode::ScaledFrame frames[AccelGyro::FIFO_MAX_FRAMES] = {};
+    const U32 count = AccelGyro::FIFO_MAX_FRAMES;
+
+    // what a drain adds with the ring attached, the writer's cost does not depend on the readers
+    this->resetCounters();
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < iterations; i++) {
+      ring.begin(count);
+      for (U32 f = 0; f < count; f++) {
+        ring.put(frames[f].accel, frames[f].gyro, static_cast<U64>(i) * count + f);
+      }
+      ring.commit();
+    }
+    const U64 elapsed = nowNs() - start;
+    g_sink = static_cast<F32>(reader.available());
+
+    const U64 samples = static_cast<U64>(iterations) * count;
+    Result result = {"sampleRing.publish", iterations, samples, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / samples;
+    result.allocsPerSample = static_cast<F64>(g_allocations - allocations) / samples;
+    return result;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchRunRegister(U32 iterations)
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::REGISTER);
+    return this->timeRun("Run_handler.register", iterations, 1);
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchRunFifo(U32 iterations)
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+
+    // every tick drains as many whole frames as the FIFO can hold
+    this->m_fifoCount = AccelGyro::FIFO_MAX_FRAMES * AccelGyro::FIFO_FRAME_SIZE;
+    return this->timeRun("Run_handler.fifo", iterations, AccelGyro::FIFO_MAX_FRAMES);
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    benchWarmPowerCycle(U32 iterations)
+  {
+    // the first power on writes the whole configuration, every one after it finds it already there
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->clearHistory();
+    this->resetCounters();
+    U64 elapsed = 0;
+    U64 allocations = 0;
+    for (U32 i = 0; i < iterations; i++) {
+      const U64 cycleAllocations = g_allocations;
+      const U64 start = nowNs();
+      this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+      this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+      elapsed += nowNs() - start;
+      allocations += g_allocations - cycleAllocations;
+      this->clearHistory();
+    }
+
+    Result result = {"power.warmCycle", iterations, iterations, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / iterations;
+    result.allocsPerSample = static_cast<F64>(allocations) / iterations;
+    result.readsPerTick = static_cast<F64>(m_reads) / iterations;
+    result.writesPerTick = static_cast<F64>(m_writes) / iterations;
+    return result;
+  }
+
+  void AccelGyroBench ::
+    report(FILE* stream, Format format, const Result* results, U32 count)
+  {
+    if (format == CSV) {
+      (void) fprintf(stream, "name,iterations,samples,ns_per_sample,allocs_per_sample,i2c_reads_per_tick,i2c_writes_per_tick\n");
+      for (U32 i = 0; i < count; i++) {
+        const Result& r = results[i];
+        (void) fprintf(stream, "%s,%u,%llu,%.3f,%.3f,%.3f,%.3f\n", r.name, r.iterations,
+                       static_cast<unsigned long long>(r.samples), r.nsPerSample, r.allocsPerSample,
+                       r.readsPerTick, r.writesPerTick);
+      }
+      return;
+    }
+
+    (void) fprintf(stream, "{\n  \"benchmarks\": [\n");
+    for (U32 i = 0; i < count; i++) {
+      const Result& r = results[i];
+      (void) fprintf(stream,
+                     "    {\"name\": \"%s\", \"iterations\": %u, \"samples\": %llu, \"ns_per_sample\": %.3f, "
+                     "\"allocs_per_sample\": %.3f, \"i2c_reads_per_tick\": %.3f, \"i2c_writes_per_tick\": %.3f}%s\n",
+                     r.name, r.iterations, static_cast<unsigned long long>(r.samples), r.nsPerSample,
+                     r.allocsPerSample, r.readsPerTick, r.writesPerTick, (i + 1 < count) ? "," : "");
+    }
+    (void) fprintf(stream, "  ]\n}\n");
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Drv::I2cStatus AccelGyroBench::
+    from_writeRead_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& writeBuffer, Fw::Buffer& readBuffer)
+  {
+    // zero-latency stub, a combined write-read counts as one read transaction and buffer contents are left as
+    // they are apart from the FIFO count and the configuration, which reads back as written
+    m_reads++;
+    this->addrBuf = writeBuffer.getData()[0];
+    const U32 window = AccelGyro::ConfigShadow::SPAN;
+    if ((this->addrBuf == AccelGyro::ConfigShadow::FIRST_ADDR) && (readBuffer.getSize() == window)) {
+      memcpy(readBuffer.getData(), &this->m_regs[this->addrBuf], readBuffer.getSize());
+    }
+    if ((this->addrBuf == AccelGyro::FIFO_COUNT_H_ADDR) && (readBuffer.getSize() == 2)) {
+      U8* const data = readBuffer.getData();
+      data[0] = static_cast<U8>(this->m_fifoCount >> 8);
+      data[1] = static_cast<U8>(this->m_fifoCount & 0xFF);
+    }
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  Fw::Buffer AccelGyroBench::
+    from_recordAllocate_handler(const NATIVE_INT_TYPE portNum, U32 size)
+  {
+    // recording is part of the timed tick, the buffer is reused since nothing reads it back
+    return Fw::Buffer(this->m_chunk, size);
+  }
+
+  Drv::I2cStatus AccelGyroBench::
+    from_write_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& serBuffer)
+  {
+    m_writes++;
+    const U8* const data = serBuffer.getData();
+    this->addrBuf = data[0];
+    for (U32 i = 1; (i < serBuffer.getSize()) && ((data[0] + i - 1) < NUM_REGISTERS); i++) {
+      this->m_regs[data[0] + i - 1] = data[i];
+    }
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void AccelGyroBench ::
+    connectPorts()
+  {
+    this->connect_to_Run(0, this->component.get_Run_InputPort(0));
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+    this->connect_to_jobDone(0, this->component.get_jobDone_InputPort(0));
+    this->connect_to_latencyRun(0, this->component.get_latencyRun_InputPort(0));
+
+    this->component.set_writeRead_OutputPort(0, this->get_from_writeRead(0));
+    this->component.set_write_OutputPort(0, this->get_from_write(0));
+    this->component.set_recordAllocate_OutputPort(0, this->get_from_recordAllocate(0));
+    this->component.set_recordOut_OutputPort(0, this->get_from_recordOut(0));
+    this->component.set_batchOut_OutputPort(0, this->get_from_batchOut(0));
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+#if FW_ENABLE_TEXT_LOGGING == 1
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+#endif
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+    this->component.set_prmGetOut_OutputPort(0, this->get_from_prmGetOut(0));
+    this->component.set_prmSetOut_OutputPort(0, this->get_from_prmSetOut(0));
+  }
+
+  void AccelGyroBench ::
+    initComponents()
+  {
+    this->init();
+    this->component.init(AccelGyroBench::TEST_INSTANCE_ID);
+  }
+
+  void AccelGyroBench ::
+    resetCounters()
+  {
+    this->clearHistory();
+    m_reads = 0;
+    m_writes = 0;
+  }
+
+  AccelGyroBench::Result AccelGyroBench ::
+    timeRun(const char* name, U32 iterations, U32 samplesPerTick)
+  {
+    this->resetCounters();
+    U64 elapsed = 0;
+    U64 allocations = 0;
+
+    // histories are cleared outside the timed region so each batch pays only for the tick
+    for (U32 done = 0; done < iterations; done += BATCH_SIZE) {
+      const U32 batch = ((iterations - done) < BATCH_SIZE) ? (iterations - done) : BATCH_SIZE;
+      const U64 batchAllocations = g_allocations;
+      const U64 start = nowNs();
+      for (U32 i = 0; i < batch; i++) {
+        this->invoke_to_Run(0, 0);
+      }
+      elapsed += nowNs() - start;
+      allocations += g_allocations - batchAllocations;
+      this->clearHistory();
+    }
+
+    const U64 samples = static_cast<U64>(iterations) * samplesPerTick;
+    Result result = {name, iterations, samples, 0, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsed) / samples;
+    result.allocsPerSample = static_cast<F64>(allocations) / samples;
+    result.readsPerTick = static_cast<F64>(m_reads) / iterations;
+    result.writesPerTick = static_cast<F64>(m_writes) / iterations;
+    return result;
+  }
+
+}
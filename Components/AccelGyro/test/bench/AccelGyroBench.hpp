@@ -0,0 +1,172 @@
+// ======================================================================
+// \title  AccelGyroBench.hpp
+// \author aidandb
+// \brief  hpp file for AccelGyro hot path micro-benchmark harness
+// ======================================================================
+
+#ifndef Components_AccelGyroBench_HPP
+#define Components_AccelGyroBench_HPP
+
+#include "Components/AccelGyro/AccelGyroTesterBase.hpp"
+#include "Components/AccelGyro/AccelGyro.hpp"
+
+#include <cstdio>
+
+namespace Components {
+
+  class AccelGyroBench :
+    public AccelGyroTesterBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Histories are cleared between timed batches so they never fill
+      static const FwSizeType MAX_HISTORY_SIZE = 1024;
+
+      // Iterations timed back to back before the histories are cleared
+      static const U32 BATCH_SIZE = 256;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Number of device registers tracked by the write handler
+      static constexpr U16 NUM_REGISTERS = 128;
+
+      //! Output format of the results
+      enum Format {
+        JSON,
+        CSV
+      };
+
+      //! Result of one benchmark
+      struct Result {
+        const char* name;
+        U32 iterations;
+        U64 samples;          //!< samples produced over all iterations
+        F64 nsPerSample;
+        F64 allocsPerSample;
+        F64 readsPerTick;     //!< I2C read port calls per iteration
+        F64 writesPerTick;    //!< I2C write port calls per iteration
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object AccelGyroBench
+      AccelGyroBench();
+
+      //! Destroy object AccelGyroBench
+      ~AccelGyroBench();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Benchmarks
+      // ----------------------------------------------------------------------
+
+      //! Decode of one vector from a register burst
+      Result benchDeserializeVector(U32 iterations);
+
+      //! Batch decode of a full FIFO worth of frames, vectorized or scalar
+      Result benchDecodeFrames(U32 iterations, bool scalar);
+
+      //! Register pointer write and burst read against the zero-latency stub
+      Result benchReadRegisterBlock(U32 iterations);
+
+      //! Stage timing of one tick, start, three marks and finish
+      Result benchStageProfiler(U32 iterations);
+
+      //! Publishing a full FIFO drain to the sample ring, begin, a put per frame and commit
+      Result benchSampleRing(U32 iterations);
+
+      //! Full Run_handler in REGISTER mode including tlmWrite_*
+      Result benchRunRegister(U32 iterations);
+
+      //! Full Run_handler in FIFO mode draining a full FIFO each tick
+      Result benchRunFifo(U32 iterations);
+
+      //! Power off and on again with the configuration already written, reads and writes are per cycle
+      Result benchWarmPowerCycle(U32 iterations);
+
+      //! Print results to a stream
+      static void report(FILE* stream, Format format, const Result* results, U32 count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Handler for typed from ports
+      // ----------------------------------------------------------------------
+
+      // Handler for from_writeRead
+      Drv::I2cStatus from_writeRead_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                             U32 addr,                         // I2c slave device address
+                                             Fw::Buffer& writeBuffer,          // Buffer with the register pointer
+                                             Fw::Buffer& readBuffer            // Buffer to read into
+      ) override;
+
+      // Handler for from_write
+      Drv::I2cStatus from_write_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                        U32 addr,                         // I2c slave device address
+                                        Fw::Buffer& serBuffer             // Buffer with data to read/write from
+      ) override;
+
+      // Handler for from_recordAllocate
+      Fw::Buffer from_recordAllocate_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                              U32 size                          // The requested size
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Reset the port call counters
+      void resetCounters();
+
+      //! Time the given number of Run ticks in batches
+      Result timeRun(const char* name, U32 iterations, U32 samplesPerTick);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      AccelGyro component;
+
+      // register pointer written by the component
+      U8 addrBuf;
+
+      // FIFO_COUNT value reported by the read handler
+      U16 m_fifoCount;
+
+      // registers as last written, read back by the power on check
+      U8 m_regs[NUM_REGISTERS];
+
+      // chunk handed out for every recording allocation, the recorder stub never writes it
+      U8 m_chunk[RawRecord::CHUNK_SIZE];
+
+      // port call counters
+      U64 m_reads;
+      U64 m_writes;
+
+  };
+
+}
+
+#endif
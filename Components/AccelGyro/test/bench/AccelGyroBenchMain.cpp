@@ -0,0 +1,78 @@
+// ======================================================================
+// \title  AccelGyroBenchMain.cpp
+// \author aidandb
+// \brief  cpp file for AccelGyro micro-benchmark main function
+// ======================================================================
+
+#include "AccelGyroBench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * \brief run the AccelGyro hot path benchmarks
+ *
+ * Usage: AccelGyro_bench [--csv] [iterations]
+ *
+ * Results go to stdout as JSON unless --csv is given. Every benchmark uses a fresh harness so state from one does not
+ * leak into the next.
+ */
+int main(int argc, char** argv) {
+  Components::AccelGyroBench::Format format = Components::AccelGyroBench::JSON;
+  U32 iterations = 100000;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      format = Components::AccelGyroBench::CSV;
+    }
+    else {
+      iterations = static_cast<U32>(strtoul(argv[i], nullptr, 10));
+    }
+  }
+  if (iterations == 0) {
+    (void) fprintf(stderr, "Usage: %s [--csv] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  const U32 fifoIterations = iterations / Components::AccelGyro::FIFO_MAX_FRAMES + 1;
+  Components::AccelGyroBench::Result results[9];
+  {
+    Components::AccelGyroBench bench;
+    results[0] = bench.benchDeserializeVector(iterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[1] = bench.benchDecodeFrames(fifoIterations, false);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[2] = bench.benchDecodeFrames(fifoIterations, true);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[3] = bench.benchReadRegisterBlock(iterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[4] = bench.benchStageProfiler(iterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[5] = bench.benchSampleRing(fifoIterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[6] = bench.benchRunRegister(iterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[7] = bench.benchRunFifo(fifoIterations);
+  }
+  {
+    Components::AccelGyroBench bench;
+    results[8] = bench.benchWarmPowerCycle(fifoIterations);
+  }
+
+  Components::AccelGyroBench::report(stdout, format, results, FW_NUM_ARRAY_ELEMENTS(results));
+  return 0;
+}
@@ -26,6 +26,36 @@ TEST(Error, setupError) {
   tester.testSetupError();
 }
 
+TEST(Nominal, registerShadow) {
+  Components::AccelGyroTester tester;
+  tester.testRegisterShadow();
+}
+
+TEST(Nominal, sampleRateParams) {
+  Components::AccelGyroTester tester;
+  tester.testSampleRateParams();
+}
+
+TEST(Nominal, fullScaleRange) {
+  Components::AccelGyroTester tester;
+  tester.testFullScaleRange();
+}
+
+TEST(BusManager, sample) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().busManager());
+  tester.testBusManagerSample();
+}
+
+TEST(BusManager, fifo) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().busManager());
+  tester.testBusManagerFifo();
+}
+
+TEST(BusManager, overrun) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().busManager());
+  tester.testBusManagerOverrun();
+}
+
 TEST(Nominal, accelTelemetry) {
   Components::AccelGyroTester tester;
   tester.testGetAccelTlm();
@@ -36,11 +66,131 @@ TEST(Nominal, gyroTelemetry) {
   tester.testGetGyroTlm();
 }
 
+TEST(Nominal, tempTelemetry) {
+  Components::AccelGyroTester tester;
+  tester.testGetTempTlm();
+}
+
+TEST(Nominal, singleTransaction) {
+  Components::AccelGyroTester tester;
+  tester.testSingleTransaction();
+}
+
+TEST(Nominal, fifoDrain) {
+  Components::AccelGyroTester tester;
+  tester.testFifoDrain();
+}
+
+TEST(Error, fifoBrownOut) {
+  Components::AccelGyroTester tester;
+  tester.testFifoBrownOut();
+}
+
+TEST(Error, fifoOverflow) {
+  Components::AccelGyroTester tester;
+  tester.testFifoOverflow();
+}
+
+TEST(Nominal, batchDecode) {
+  Components::AccelGyroTester tester;
+  tester.testBatchDecode();
+}
+
+TEST(Decimation, filters) {
+  Components::AccelGyroTester tester;
+  tester.testDecimatorFilters();
+}
+
+TEST(Decimation, fifo) {
+  Components::AccelGyroTester tester;
+  tester.testDecimatedFifo();
+}
+
+TEST(Decimation, configError) {
+  Components::AccelGyroTester tester;
+  tester.testDecimationConfigError();
+}
+
+TEST(Recording, chunk) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().recorder());
+  tester.testRecordChunk();
+}
+
+TEST(Recording, fullChunk) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().recorder());
+  tester.testRecordFullChunk();
+}
+
+TEST(Batching, packet) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().batcher());
+  tester.testBatchPacket();
+}
+
+TEST(Processing, sampleOut) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().sampler());
+  tester.testSampleOut();
+}
+
+TEST(Processing, sampleClock) {
+  Components::AccelGyroTester tester;
+  tester.testSampleClock();
+}
+
+TEST(Processing, fifoTimestamps) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().sampler());
+  tester.testFifoTimestamps();
+}
+
+TEST(DataReady, edge) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().sampler());
+  tester.testDataReady();
+}
+
+TEST(DataReady, busManager) {
+  Components::AccelGyroTester tester(Components::AccelGyroTester::Wiring().busManager().sampler());
+  tester.testDataReadyJob();
+}
+
+TEST(DataReady, backoff) {
+  Components::AccelGyroTester tester;
+  tester.testDataReadyBackoff();
+}
+
+TEST(Nominal, deadband) {
+  Components::AccelGyroTester tester;
+  tester.testDeadband();
+}
+
+TEST(Nominal, rawTelemetry) {
+  Components::AccelGyroTester tester;
+  tester.testRawTelemetry();
+}
+
+TEST(SampleRing, readers) {
+  Components::AccelGyroTester tester;
+  tester.testSampleRing();
+}
+
+TEST(SampleRing, publish) {
+  Components::AccelGyroTester tester;
+  tester.testSampleRingPublish();
+}
+
+TEST(Profiling, stageLatency) {
+  Components::AccelGyroTester tester;
+  tester.testStageLatency();
+}
+
 TEST(Error, tlmError) {
   Components::AccelGyroTester tester;
   tester.testTlmError();
 }
 
+TEST(Error, busBackoff) {
+  Components::AccelGyroTester tester;
+  tester.testBusBackoff();
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -6,6 +6,11 @@
 
 #include "AccelGyroTester.hpp"
 
+#include "Fw/Com/ComPacket.hpp"
+
+#include <atomic>
+#include <thread>
+
 // Testing framework provided by Fprime gives 
 #include "STest/STest/Pick/Pick.hpp"
 
@@ -19,17 +24,28 @@ namespace Components {
   // ----------------------------------------------------------------------
 
   AccelGyroTester ::
-    AccelGyroTester() :
+    AccelGyroTester(const Wiring& wiring) :
       AccelGyroGTestBase("AccelGyroTester", AccelGyroTester::MAX_HISTORY_SIZE),
       component("AccelGyro"),
+      m_busManager(wiring.m_busManager),
+      m_recorder(wiring.m_recorder),
+      m_batcher(wiring.m_batcher),
+      m_sampler(wiring.m_sampler),
+      m_chunkAvailable(true),
+      m_chunkIndex(0),
       addrBuf(0),
-      accelSerBuf(this->accelBuf, sizeof this->accelBuf),
-      gyroSerBuf(this->gyroBuf, sizeof this->gyroBuf)
+      m_fifoCount(0),
+      sampleSerBuf(this->sampleBuf, sizeof this->sampleBuf),
+      fifoSerBuf(this->fifoBuf, sizeof this->fifoBuf)
   {
-    memset(this->accelBuf, 0, sizeof this->accelBuf);
-    memset(this->gyroBuf, 0, sizeof this->gyroBuf);
+    memset(this->writtenRegs, 0, sizeof this->writtenRegs);
+    memset(this->m_writes, 0, sizeof this->m_writes);
+    memset(this->sampleBuf, 0, sizeof this->sampleBuf);
+    memset(this->fifoBuf, 0, sizeof this->fifoBuf);
+    memset(this->m_chunkBufs, 0xFF, sizeof this->m_chunkBufs);
     this->initComponents();
     this->connectPorts();
+    this->component.loadParameters();
     this->component.setup(ADDRESS_TEST);
   }
 
@@ -43,6 +59,145 @@ namespace Components {
   // Tests
   // ----------------------------------------------------------------------
   
+  void AccelGyroTester ::
+    testFullScaleRange()
+  {
+    // ranges set before power on are applied with the rest of the configuration
+    this->paramSet_ACCEL_RANGE(Components::AccelRange::G8, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_RANGE(0, 0);
+    this->paramSet_GYRO_RANGE(Components::GyroRange::DPS2000, Fw::ParamValid::VALID);
+    this->paramSend_GYRO_RANGE(0, 0);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::ACCEL_CONFIG_ADDR], 0x10);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::GYRO_CONFIG_ADDR], 0x18);
+
+    this->invoke_to_Run(0, 0);
+    this->checkSampleTlm(0, AccelGyro::accelScaleFactors[Components::AccelRange::G8],
+                         AccelGyro::gyroScaleFactors[Components::GyroRange::DPS2000]);
+
+    // a powered device switches range and scale factor together
+    this->paramSet_ACCEL_RANGE(Components::AccelRange::G16, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_RANGE(0, 0);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::ACCEL_CONFIG_ADDR], 0x18);
+
+    this->invoke_to_Run(0, 0);
+    this->checkSampleTlm(1, AccelGyro::accelScaleFactors[Components::AccelRange::G16],
+                         AccelGyro::gyroScaleFactors[Components::GyroRange::DPS2000]);
+
+    // a rejected range write keeps the old scale factor
+    this->m_writeStatus = Drv::I2cStatus::I2C_WRITE_ERR;
+    this->paramSet_GYRO_RANGE(Components::GyroRange::DPS250, Fw::ParamValid::VALID);
+    this->paramSend_GYRO_RANGE(0, 0);
+    ASSERT_EVENTS_ConfigError_SIZE(1);
+
+    this->m_writeStatus = Drv::I2cStatus::I2C_OK;
+    this->invoke_to_Run(0, 0);
+    this->checkSampleTlm(2, AccelGyro::accelScaleFactors[Components::AccelRange::G16],
+                         AccelGyro::gyroScaleFactors[Components::GyroRange::DPS2000]);
+  }
+
+
+  void AccelGyroTester ::
+    testBusManagerSample()
+  {
+    // configuration still goes out synchronously
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EVENTS_ConfigError_SIZE(0);
+    this->clearFromPortHistory();
+
+    // Run only queues the burst read
+    const U8 sampleStart = AccelGyro::SAMPLE_DATA_START;
+    const U32 sampleSize = AccelGyro::MAX_DATA_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_writeRead_SIZE(0);
+    ASSERT_from_jobOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(0).addr, ADDRESS_TEST);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(0).writeBuffer.getData()[0], sampleStart);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(0).readBuffer.getSize(), sampleSize);
+    ASSERT_TLM_accelerometer_SIZE(0);
+
+    // telemetry follows the completion
+    this->completeJob(0, Drv::I2cStatus::I2C_OK);
+    ASSERT_TLM_temperature_SIZE(1);
+    this->checkSampleTlm(0, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor);
+
+    // a failed job is reported like a failed read
+    this->invoke_to_Run(0, 0);
+    this->completeJob(1, Drv::I2cStatus::I2C_ADDRESS_ERR);
+    ASSERT_EVENTS_TelemetryError_SIZE(1);
+    ASSERT_EVENTS_TelemetryError(0, Drv::I2cStatus::I2C_ADDRESS_ERR, 1);
+    ASSERT_TLM_accelerometer_SIZE(1);
+  }
+
+
+  void AccelGyroTester ::
+    testBusManagerFifo()
+  {
+    const U32 frames = 5;
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->clearFromPortHistory();
+
+    // the count is read first
+    const U8 countAddr = AccelGyro::FIFO_COUNT_H_ADDR;
+    const U32 countSize = AccelGyro::FIFO_COUNT_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_jobOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(0).writeBuffer.getData()[0], countAddr);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(0).readBuffer.getSize(), countSize);
+
+    // its completion queues one block read for every whole frame
+    this->completeJob(0, Drv::I2cStatus::I2C_OK);
+    const U8 fifoAddr = AccelGyro::FIFO_R_W_ADDR;
+    const U32 drainSize = frames * AccelGyro::FIFO_FRAME_SIZE;
+    ASSERT_from_jobOut_SIZE(2);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(1).writeBuffer.getData()[0], fifoAddr);
+    ASSERT_EQ(this->fromPortHistory_jobOut->at(1).readBuffer.getSize(), drainSize);
+    ASSERT_TLM_fifoFramesDrained(0, frames);
+    ASSERT_TLM_accelerometer_SIZE(0);
+
+    this->completeJob(1, Drv::I2cStatus::I2C_OK);
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_gyroscope_SIZE(1);
+
+    // an empty FIFO needs no second read
+    this->m_fifoCount = 0;
+    this->invoke_to_Run(0, 0);
+    this->completeJob(2, Drv::I2cStatus::I2C_OK);
+    ASSERT_from_jobOut_SIZE(3);
+  }
+
+
+  void AccelGyroTester ::
+    testBusManagerOverrun()
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+
+    // a tick that finds the last read still queued is skipped
+    this->invoke_to_Run(0, 0);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_jobOut_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns(0, 1);
+
+    this->completeJob(0, Drv::I2cStatus::I2C_OK);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_jobOut_SIZE(2);
+
+    // a completion after power off is dropped and the next power on starts clean
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+    this->completeJob(1, Drv::I2cStatus::I2C_OK);
+    ASSERT_TLM_accelerometer_SIZE(1);
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_jobOut_SIZE(3);
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+  }
+
+
   void AccelGyroTester ::
     testGetAccelTlm()
   {
@@ -57,7 +212,7 @@ namespace Components {
     // loop through and collects x, y, and z outputs
     for (U32 j = 0; j < 3; j++) {
       I16 coords = 0;
-      const auto status = this->accelSerBuf.deserialize(coords);
+      const auto status = this->sampleSerBuf.deserialize(coords);
       EXPECT_EQ(status, Fw::FW_SERIALIZE_OK);
       const F32 f32Coord = static_cast<F32>(coords) / AccelGyro::accelScaleFactor;
       expectedVect[j] = f32Coord;
@@ -76,13 +231,19 @@ namespace Components {
     ASSERT_EVENTS_PowerModeError_SIZE(0);
     this->invoke_to_Run(0, 0);
 
-    // create array for storing accel values
+    // skip over accel x, y, z and temperature which precede the gyro registers
+    for (U32 j = 0; j < 4; j++) {
+      I16 skipped = 0;
+      EXPECT_EQ(this->sampleSerBuf.deserialize(skipped), Fw::FW_SERIALIZE_OK);
+    }
+
+    // create array for storing gyro values
     Components::F32x3 expectedVect;
     
     // loop through and collects x, y, and z outputs
     for (U32 j = 0; j < 3; j++) {
       I16 coords = 0;
-      const auto status = this->gyroSerBuf.deserialize(coords);
+      const auto status = this->sampleSerBuf.deserialize(coords);
       EXPECT_EQ(status, Fw::FW_SERIALIZE_OK);
       const F32 f32Coord = static_cast<F32>(coords) / AccelGyro::gyroScaleFactor;
       expectedVect[j] = f32Coord;
@@ -93,6 +254,746 @@ namespace Components {
   }
 
 
+  void AccelGyroTester ::
+    testGetTempTlm()
+  {
+    // turn on I2C device
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EVENTS_PowerModeError_SIZE(0);
+    this->invoke_to_Run(0, 0);
+
+    // skip over accel x, y, z which precede the temperature register
+    for (U32 j = 0; j < 3; j++) {
+      I16 skipped = 0;
+      EXPECT_EQ(this->sampleSerBuf.deserialize(skipped), Fw::FW_SERIALIZE_OK);
+    }
+
+    I16 rawTemp = 0;
+    EXPECT_EQ(this->sampleSerBuf.deserialize(rawTemp), Fw::FW_SERIALIZE_OK);
+    const F32 expectedTemp = (static_cast<F32>(rawTemp) / AccelGyro::tempScaleFactor) + AccelGyro::tempOffset;
+
+    ASSERT_TLM_temperature_SIZE(1);
+    ASSERT_TLM_temperature(0, expectedTemp);
+  }
+
+
+  void AccelGyroTester ::
+    testSingleTransaction()
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->clearFromPortHistory();
+
+    // the register pointer write and burst read share one transaction per tick
+    const U8 sampleStart = AccelGyro::SAMPLE_DATA_START;
+    const U32 sampleSize = AccelGyro::MAX_DATA_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_write_SIZE(0);
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EQ(this->addrBuf, sampleStart);
+    ASSERT_EQ(this->fromPortHistory_writeRead->at(0).writeBuffer.getSize(), 1);
+    ASSERT_EQ(this->fromPortHistory_writeRead->at(0).readBuffer.getSize(), sampleSize);
+
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_temperature_SIZE(1);
+    ASSERT_TLM_gyroscope_SIZE(1);
+  }
+
+
+  void AccelGyroTester ::
+    testFifoDrain()
+  {
+    const U32 frames = 5;
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->clearFromPortHistory();
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    ASSERT_CMD_RESPONSE(1, AccelGyro::OPCODE_SET_ACQUISITION_MODE, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_AcquisitionModeSet(0, Components::AcquisitionMode::FIFO);
+    ASSERT_from_write_SIZE(5);
+    this->checkFifoReset(0);
+
+    // a trailing partial frame must be left in the FIFO
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE + 3;
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+
+    // one read for the count and one block read for every whole frame
+    const U32 drainSize = frames * AccelGyro::FIFO_FRAME_SIZE;
+    ASSERT_from_writeRead_SIZE(2);
+    ASSERT_EQ(this->fromPortHistory_writeRead->at(1).readBuffer.getSize(), drainSize);
+    ASSERT_TLM_fifoFramesDrained(0, frames);
+
+    // telemetry carries the newest frame
+    for (U32 j = 0; j < (frames - 1) * 6; j++) {
+      I16 skipped = 0;
+      EXPECT_EQ(this->fifoSerBuf.deserialize(skipped), Fw::FW_SERIALIZE_OK);
+    }
+
+    Components::F32x3 expectedAccel;
+    Components::F32x3 expectedGyro;
+    for (U32 j = 0; j < 3; j++) {
+      I16 coords = 0;
+      EXPECT_EQ(this->fifoSerBuf.deserialize(coords), Fw::FW_SERIALIZE_OK);
+      expectedAccel[j] = static_cast<F32>(coords) / AccelGyro::accelScaleFactor;
+    }
+    for (U32 j = 0; j < 3; j++) {
+      I16 coords = 0;
+      EXPECT_EQ(this->fifoSerBuf.deserialize(coords), Fw::FW_SERIALIZE_OK);
+      expectedGyro[j] = static_cast<F32>(coords) / AccelGyro::gyroScaleFactor;
+    }
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_accelerometer(0, expectedAccel);
+    ASSERT_TLM_gyroscope_SIZE(1);
+    ASSERT_TLM_gyroscope(0, expectedGyro);
+  }
+
+
+  void AccelGyroTester ::
+    testFifoBrownOut()
+  {
+    const U32 frames = 3;
+    const U8 fifoEnable = AccelGyro::USER_CTRL_FIFO_EN;
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_fifoFramesDrained_SIZE(1);
+
+    // a brown-out puts every register back to its reset value, the FIFO stops queueing
+    memset(this->writtenRegs, 0, sizeof this->writtenRegs);
+    this->writtenRegs[AccelGyro::POWER_MGMT_ADDR] = AccelGyro::POWER_OFF;
+    this->clearHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_fifoFramesDrained(0, 0);
+    ASSERT_TLM_accelerometer_SIZE(0);
+
+    // powering on again repairs the shadowed registers, then sets the FIFO up from scratch
+    this->clearFromPortHistory();
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EVENTS_ConfigMismatch_SIZE(1);
+    const U32 writes = this->fromPortHistory_write->size();
+    ASSERT_GE(writes, 5);
+    this->checkFifoReset(writes - 5);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::USER_CTRL_ADDR], fifoEnable);
+
+    // and frames come out again
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_fifoFramesDrained_SIZE(2);
+    ASSERT_TLM_fifoFramesDrained(1, frames);
+    ASSERT_TLM_accelerometer_SIZE(1);
+  }
+
+
+  void AccelGyroTester ::
+    testFifoOverflow()
+  {
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+
+    this->m_fifoCount = AccelGyro::FIFO_SIZE_BYTES;
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+
+    // nothing is drained and the FIFO is reset
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EVENTS_FifoOverflow_SIZE(1);
+    ASSERT_EVENTS_FifoOverflow(0, AccelGyro::FIFO_SIZE_BYTES);
+    ASSERT_TLM_fifoOverflows(0, 1);
+    ASSERT_TLM_accelerometer_SIZE(0);
+
+    // queueing is stopped before the reset, an enabled FIFO would ignore it and overflow again on the next tick
+    ASSERT_from_write_SIZE(5);
+    this->checkFifoReset(0);
+  }
+
+
+  void AccelGyroTester ::
+    testBatchDecode()
+  {
+    const U32 maxFrames = AccelGyro::FIFO_MAX_FRAMES;
+    U8 raw[AccelGyro::FIFO_MAX_FRAMES * AccelGyro::FIFO_FRAME_SIZE];
+    for (U32 i = 0; i < sizeof raw; i++) {
+      raw[i] = static_cast<U8>(STest::Pick::any());
+    }
+
+    // extremes of the I16 range in the first frame
+    const U8 extremes[6] = {0x80, 0x00, 0x7F, 0xFF, 0xFF, 0xFF};
+    memcpy(raw, extremes, sizeof extremes);
+    memcpy(&raw[6], extremes, sizeof extremes);
+
+    // every frame count exercises both the vector body and the scalar tail
+    SampleDecode::ScaledFrame frames[AccelGyro::FIFO_MAX_FRAMES];
+    for (U32 count = 0; count <= maxFrames; count++) {
+      SampleDecode::decodeFrames(raw, count, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor, frames);
+
+      // bit-exact with the single sample path
+      for (U32 i = 0; i < count; i++) {
+        const U8* const frame = &raw[i * AccelGyro::FIFO_FRAME_SIZE];
+        const F32x3 accel = this->component.deserializeVector(&frame[0], AccelGyro::accelScaleFactor);
+        const F32x3 gyro = this->component.deserializeVector(&frame[6], AccelGyro::gyroScaleFactor);
+        for (U32 axis = 0; axis < 3; axis++) {
+          ASSERT_EQ(memcmp(&frames[i].accel[axis], &accel[axis], sizeof(F32)), 0);
+          ASSERT_EQ(memcmp(&frames[i].gyro[axis], &gyro[axis], sizeof(F32)), 0);
+        }
+      }
+    }
+  }
+
+
+  void AccelGyroTester ::
+    testDecimatorFilters()
+  {
+    typedef Decimator<1, 8, 4> TestDecimator;
+    TestDecimator decimator;
+
+    // one output per ratio inputs, the mean of the window
+    ASSERT_TRUE(decimator.configure(TestDecimator::MOVING_AVERAGE, 4, nullptr, 0));
+    for (I16 x = 1; x <= 8; x++) {
+      ASSERT_EQ(decimator.push(&x), (x % 4) == 0);
+    }
+    ASSERT_EQ(decimator.output()[0], 6.5f);
+
+    // the CIC settles to unity gain after one period per stage
+    ASSERT_TRUE(decimator.configure(TestDecimator::CIC, 4, nullptr, 0));
+    const I16 level = -100;
+    for (U32 i = 0; i < 4 * TestDecimator::CIC_STAGES; i++) {
+      (void) decimator.push(&level);
+    }
+    ASSERT_EQ(decimator.output()[0], -100.0f);
+
+    // taps apply newest sample first and only on output
+    const F32 taps[3] = {0.5f, 0.25f, 0.25f};
+    ASSERT_TRUE(decimator.configure(TestDecimator::FIR, 2, taps, 3));
+    const I16 ramp[4] = {4, 8, 12, 16};
+    for (U32 i = 0; i < 4; i++) {
+      ASSERT_EQ(decimator.push(&ramp[i]), (i % 2) == 1);
+    }
+    ASSERT_EQ(decimator.output()[0], 13.0f);
+
+    // settings the ring cannot hold are refused and the filter is left as it was
+    ASSERT_FALSE(decimator.configure(TestDecimator::MOVING_AVERAGE, 0, nullptr, 0));
+    ASSERT_FALSE(decimator.configure(TestDecimator::MOVING_AVERAGE, 9, nullptr, 0));
+    ASSERT_FALSE(decimator.configure(TestDecimator::FIR, 2, taps, 5));
+    ASSERT_FALSE(decimator.configure(TestDecimator::FIR, 2, nullptr, 3));
+    ASSERT_EQ(decimator.type(), TestDecimator::FIR);
+    ASSERT_EQ(decimator.ratio(), 2U);
+  }
+
+
+  void AccelGyroTester ::
+    testDecimatedFifo()
+  {
+    const U32 frames = 5;
+
+    this->paramSet_DECIMATION_FILTER(Components::DecimationFilter::MOVING_AVERAGE, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_FILTER(0, 0);
+    this->paramSet_DECIMATION_RATIO(frames, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_RATIO(0, 0);
+    ASSERT_EVENTS_DecimationConfigError_SIZE(0);
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+
+    // every frame since the last tick contributes to the one output
+    I32 sums[AccelGyro::DECIMATOR_CHANNELS] = {};
+    for (U32 i = 0; i < frames; i++) {
+      for (U32 c = 0; c < AccelGyro::DECIMATOR_CHANNELS; c++) {
+        I16 raw = 0;
+        EXPECT_EQ(this->fifoSerBuf.deserialize(raw), Fw::FW_SERIALIZE_OK);
+        sums[c] += raw;
+      }
+    }
+
+    Components::F32x3 expectedAccel;
+    Components::F32x3 expectedGyro;
+    for (U32 j = 0; j < 3; j++) {
+      expectedAccel[j] = (static_cast<F32>(sums[j]) / static_cast<F32>(frames)) / AccelGyro::accelScaleFactor;
+      expectedGyro[j] = (static_cast<F32>(sums[j + 3]) / static_cast<F32>(frames)) / AccelGyro::gyroScaleFactor;
+    }
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_accelerometer(0, expectedAccel);
+    ASSERT_TLM_gyroscope_SIZE(1);
+    ASSERT_TLM_gyroscope(0, expectedGyro);
+
+    // a tick short of a full period publishes nothing
+    this->m_fifoCount = (frames - 1) * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_accelerometer_SIZE(1);
+  }
+
+
+  void AccelGyroTester ::
+    testDecimationConfigError()
+  {
+    // a zero ratio is refused and samples go out unfiltered
+    this->paramSet_DECIMATION_FILTER(Components::DecimationFilter::CIC, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_FILTER(0, 0);
+    this->paramSet_DECIMATION_RATIO(0, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_RATIO(0, 0);
+    ASSERT_EVENTS_DecimationConfigError_SIZE(1);
+    ASSERT_EVENTS_DecimationConfigError(0, Components::DecimationFilter::CIC, 0);
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->invoke_to_Run(0, 0);
+    this->checkSampleTlm(0, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor);
+  }
+
+
+  void AccelGyroTester ::
+    testRecordChunk()
+  {
+    const U32 frames = 5;
+    const U32 periodUs = AccelGyro::GYRO_PERIOD_US_DLPF_ON;
+
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+
+    // a chunk is held until it fills
+    ASSERT_from_recordAllocate_SIZE(1);
+    ASSERT_from_recordOut_SIZE(0);
+
+    // power off sends it as it is
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+    ASSERT_from_recordOut_SIZE(1);
+    const Fw::Buffer chunk = this->fromPortHistory_recordOut->at(0).fwBuffer;
+    const U32 chunkSize = RawRecord::CHUNK_SIZE;
+    ASSERT_EQ(chunk.getSize(), chunkSize);
+    const U8* const data = chunk.getData();
+
+    // the chunk is dated by its oldest frame, one sample period per frame before the drain
+    ASSERT_EQ((data[0] << 8) | data[1], RawRecord::MAGIC);
+    ASSERT_EQ((data[2] << 8) | data[3], frames);
+    const U32 source = (data[4] << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+    ASSERT_EQ(source, this->component.getIdBase());
+    const U32 seconds = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
+    const U32 useconds = (data[12] << 24) | (data[13] << 16) | (data[14] << 8) | data[15];
+    ASSERT_EQ(seconds, 100);
+    ASSERT_EQ(useconds, 500000 - (frames - 1) * periodUs);
+
+    // frames are stored exactly as read
+    for (U32 i = 0; i < frames; i++) {
+      const U8* const record = &data[RawRecord::HEADER_SIZE + i * RawRecord::RECORD_SIZE];
+      const U32 offset = (record[0] << 24) | (record[1] << 16) | (record[2] << 8) | record[3];
+      ASSERT_EQ(offset, i * periodUs);
+      ASSERT_EQ(memcmp(&record[RawRecord::AXES_OFFSET], &this->fifoBuf[i * AccelGyro::FIFO_FRAME_SIZE],
+                       AccelGyro::FIFO_FRAME_SIZE), 0);
+    }
+
+    // unused records are zero
+    for (U32 i = RawRecord::HEADER_SIZE + frames * RawRecord::RECORD_SIZE; i < chunkSize; i++) {
+      ASSERT_EQ(data[i], 0);
+    }
+  }
+
+
+  void AccelGyroTester ::
+    testRecordFullChunk()
+  {
+    const U32 frames = RawRecord::RECORDS_PER_CHUNK / 3;
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+
+    // the chunk goes out as soon as its last record is written
+    for (U32 i = 0; i < 3; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_from_recordAllocate_SIZE(1);
+    ASSERT_from_recordOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_recordOut->at(0).fwBuffer.getData()[3], RawRecord::RECORDS_PER_CHUNK);
+
+    // with the buffer manager empty samples are counted and dropped
+    const U32 dropped = 4;
+    this->m_chunkAvailable = false;
+    this->m_fifoCount = dropped * AccelGyro::FIFO_FRAME_SIZE;
+    this->clearHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_recordAllocate_SIZE(dropped);
+    ASSERT_TLM_recordsDropped_SIZE(dropped);
+    ASSERT_TLM_recordsDropped(dropped - 1, dropped);
+
+    // and recording picks up again once a chunk is free
+    this->m_chunkAvailable = true;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_recordAllocate_SIZE(dropped + 1);
+    ASSERT_from_recordOut_SIZE(0);
+  }
+
+
+  void AccelGyroTester ::
+    testBatchPacket()
+  {
+    const U32 batchRecords = AccelGyro::BATCH_RECORDS;
+    const U32 frames = batchRecords + 2;
+    const U32 periodUs = AccelGyro::GYRO_PERIOD_US_DLPF_ON;
+
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+
+    // a full batch goes out at once, the rest waits for the next one
+    ASSERT_from_batchOut_SIZE(1);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+    ASSERT_from_batchOut_SIZE(2);
+
+    const U64 oldestUs = 100500000 - (frames - 1) * periodUs;
+    U32 frame = 0;
+    for (U32 p = 0; p < 2; p++) {
+      Fw::ComBuffer packet = this->fromPortHistory_batchOut->at(p).data;
+      const U32 count = (p == 0) ? batchRecords : frames - batchRecords;
+      FwPacketDescriptorType descriptor = 0;
+      ASSERT_EQ(packet.deserialize(descriptor), Fw::FW_SERIALIZE_OK);
+      ASSERT_EQ(descriptor, static_cast<FwPacketDescriptorType>(Fw::ComPacket::FW_PACKET_HAND));
+      ASSERT_EQ(packet.getBuffLength(),
+                sizeof(FwPacketDescriptorType) + RawRecord::HEADER_SIZE + count * RawRecord::RECORD_SIZE);
+
+      // same header as a recorded chunk, dated by the oldest sample in the packet
+      const U8* const data = packet.getBuffAddr() + sizeof(FwPacketDescriptorType);
+      ASSERT_EQ((data[0] << 8) | data[1], RawRecord::MAGIC);
+      ASSERT_EQ((data[2] << 8) | data[3], count);
+      const U32 source = (data[4] << 24) | (data[5] << 16) | (data[6] << 8) | data[7];
+      ASSERT_EQ(source, this->component.getIdBase());
+      const U64 baseUs = oldestUs + frame * periodUs;
+      const U32 seconds = (data[8] << 24) | (data[9] << 16) | (data[10] << 8) | data[11];
+      const U32 useconds = (data[12] << 24) | (data[13] << 16) | (data[14] << 8) | data[15];
+      ASSERT_EQ(seconds, baseUs / 1000000);
+      ASSERT_EQ(useconds, baseUs % 1000000);
+
+      for (U32 i = 0; i < count; i++, frame++) {
+        const U8* const record = &data[RawRecord::HEADER_SIZE + i * RawRecord::RECORD_SIZE];
+        const U32 offset = (record[0] << 24) | (record[1] << 16) | (record[2] << 8) | record[3];
+        ASSERT_EQ(offset, i * periodUs);
+        ASSERT_EQ(memcmp(&record[RawRecord::AXES_OFFSET], &this->fifoBuf[frame * AccelGyro::FIFO_FRAME_SIZE],
+                         AccelGyro::FIFO_FRAME_SIZE), 0);
+      }
+    }
+  }
+
+
+  void AccelGyroTester ::
+    testSampleOut()
+  {
+    const U32 frames = 5;
+    const U32 periodUs = AccelGyro::GYRO_PERIOD_US_DLPF_ON;
+
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+
+    // every frame goes out scaled and dated, oldest first
+    ASSERT_from_sampleOut_SIZE(frames);
+    for (U32 i = 0; i < frames; i++) {
+      const U8* const frame = &this->fifoBuf[i * AccelGyro::FIFO_FRAME_SIZE];
+      const FromPortEntry_sampleOut& sample = this->fromPortHistory_sampleOut->at(i);
+      ASSERT_EQ(sample.timeUs, 100500000 - (frames - 1 - i) * periodUs);
+      for (U32 axis = 0; axis < 3; axis++) {
+        ASSERT_FLOAT_EQ(sample.accel[axis], SampleDecode::scaleAxis(&frame[2 * axis], AccelGyro::accelScaleFactor));
+        ASSERT_FLOAT_EQ(sample.gyro[axis], SampleDecode::scaleAxis(&frame[6 + 2 * axis], AccelGyro::gyroScaleFactor));
+      }
+    }
+
+    // register mode sends the one sample it reads
+    this->clearHistory();
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::REGISTER);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_sampleOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(0).timeUs, 100500000);
+    const F32 expectedGyroZ =
+        SampleDecode::scaleAxis(&this->sampleBuf[AccelGyro::GYRO_DATA_OFFSET + 4], AccelGyro::gyroScaleFactor);
+    ASSERT_FLOAT_EQ(this->fromPortHistory_sampleOut->at(0).gyro[2], expectedGyroZ);
+  }
+
+
+  void AccelGyroTester ::
+    testSampleClock()
+  {
+    const U32 devicePeriodUs = 1020;
+    SampleClock clock;
+    clock.configure(1000);
+
+    // the device samples 2% slow, drained every 5 ms with up to 400 us of read latency
+    U32 produced = 0;
+    U64 lastUs = 0;
+    U64 hostUs = 0;
+    for (U32 drain = 1; drain <= 2000; drain++) {
+      hostUs = drain * 5000 + (drain * 7919) % 400;
+      U32 frames = 0;
+      while (produced * devicePeriodUs + 50 <= hostUs) {
+        produced++;
+        frames++;
+      }
+      clock.drain(hostUs, frames);
+
+      // once settled, frames are a device period apart within and across drains whatever the latency
+      if (drain > 1000) {
+        for (U32 age = frames; age-- > 0;) {
+          const U64 frameUs = clock.frameUs(age);
+          if (lastUs != 0) {
+            ASSERT_GT(frameUs, lastUs + devicePeriodUs - 60);
+            ASSERT_LT(frameUs, lastUs + devicePeriodUs + 60);
+          }
+          lastUs = frameUs;
+        }
+      }
+    }
+    ASSERT_NEAR(clock.driftPpm(), 20000, 500);
+
+    // a host clock stepped back dates the drain from the read again, the tracked period is kept
+    clock.drain(hostUs - 1000000, 5);
+    ASSERT_EQ(clock.frameUs(0), hostUs - 1000000);
+    ASSERT_NEAR(clock.driftPpm(), 20000, 500);
+
+    // so does the same period configured again, a new one starts from nominal
+    clock.configure(1000);
+    ASSERT_NEAR(clock.driftPpm(), 20000, 500);
+    clock.drain(hostUs + 10000, 5);
+    ASSERT_EQ(clock.frameUs(0), hostUs + 10000);
+    clock.configure(2000);
+    ASSERT_EQ(clock.driftPpm(), 0);
+
+    // the host clock is the epoch in microseconds, the first drain is dated from its read and the next one follows it
+    const U64 epochUs = 1700000000000000;
+    SampleClock epochClock;
+    epochClock.configure(1000);
+    epochClock.drain(epochUs, 5);
+    ASSERT_EQ(epochClock.frameUs(0), epochUs);
+    ASSERT_EQ(epochClock.frameUs(4), epochUs - 4000);
+    epochClock.drain(epochUs + 5000, 5);
+    ASSERT_EQ(epochClock.frameUs(0), epochUs + 5000);
+    ASSERT_EQ(epochClock.driftPpm(), 0);
+
+    // a drain far past the prediction starts over without the gap ever being scaled
+    epochClock.drain(epochUs + 3600000000, 5);
+    ASSERT_EQ(epochClock.frameUs(0), epochUs + 3600000000);
+  }
+
+
+  void AccelGyroTester ::
+    testFifoTimestamps()
+  {
+    const U32 frames = 5;
+    const U32 periodUs = AccelGyro::GYRO_PERIOD_US_DLPF_ON;
+
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_sampleOut_SIZE(frames);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(frames - 1).timeUs, 100500000);
+
+    // the next drain is read late, its frames still follow on a period apart rather than jumping with the read
+    this->setTestTime(Fw::Time(TB_NONE, 100, 505800));
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_sampleOut_SIZE(2 * frames);
+    for (U32 i = frames; i < 2 * frames; i++) {
+      const U64 stepUs =
+          this->fromPortHistory_sampleOut->at(i).timeUs - this->fromPortHistory_sampleOut->at(i - 1).timeUs;
+      ASSERT_GE(stepUs, periodUs);
+      ASSERT_LT(stepUs, periodUs + 100);
+    }
+    ASSERT_LT(this->fromPortHistory_sampleOut->at(2 * frames - 1).timeUs, 100505800);
+    ASSERT_TLM_sampleClockDrift_SIZE(2);
+    ASSERT_GT(this->tlmHistory_sampleClockDrift->at(1).arg, 0);
+
+    // a FIFO reset starts over from the read
+    this->clearFromPortHistory();
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->setTestTime(Fw::Time(TB_NONE, 100, 520000));
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_sampleOut_SIZE(frames);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(frames - 1).timeUs, 100520000);
+  }
+
+
+  void AccelGyroTester ::
+    testDataReady()
+  {
+    const U8 intPinAddr = AccelGyro::INT_PIN_CFG_ADDR;
+    const U8 dataReadyEnable = AccelGyro::INT_ENABLE_DATA_RDY;
+    const U8 pulsedReadClear = 0x10;
+    const U8 noInterrupts = AccelGyro::INT_ENABLE_NONE;
+
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::INT_ENABLE_ADDR], noInterrupts);
+    this->clearFromPortHistory();
+
+    // a powered device is switched over at once, the pin setup and interrupt enable go out in one burst
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::DATA_READY);
+    ASSERT_EVENTS_AcquisitionModeSet(0, Components::AcquisitionMode::DATA_READY);
+    ASSERT_EQ(this->m_writes[0].address, intPinAddr);
+    ASSERT_EQ(this->m_writes[0].size, 3);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::INT_PIN_CFG_ADDR], pulsedReadClear);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::INT_ENABLE_ADDR], dataReadyEnable);
+
+    // the tick reads nothing, the edge reads the sample and dates it
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_writeRead_SIZE(0);
+    this->invoke_to_dataReady(0, 100499950);
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_from_sampleOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(0).timeUs, 100499950);
+    ASSERT_TLM_accelerometer_SIZE(1);
+    this->checkSampleTlm(0, AccelGyro::accelScaleFactor, AccelGyro::gyroScaleFactor);
+
+    // back in register mode the interrupt is off, a late edge is ignored and the tick samples again
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::REGISTER);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::INT_ENABLE_ADDR], noInterrupts);
+    this->clearFromPortHistory();
+    this->invoke_to_dataReady(0, 100501000);
+    ASSERT_from_writeRead_SIZE(0);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_sampleOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(0).timeUs, 100500000);
+  }
+
+
+  void AccelGyroTester ::
+    testDataReadyJob()
+  {
+    const U8 dataReadyEnable = AccelGyro::INT_ENABLE_DATA_RDY;
+
+    // the mode chosen while off is set up at power on
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::DATA_READY);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::INT_ENABLE_ADDR], dataReadyEnable);
+
+    // the edge only queues the read, an edge that finds it still queued is an overrun and does not re-date it
+    this->invoke_to_dataReady(0, 2000);
+    this->invoke_to_dataReady(0, 3000);
+    ASSERT_from_jobOut_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns_SIZE(1);
+    ASSERT_TLM_acquisitionOverruns(0, 1);
+
+    this->completeJob(0, Drv::I2cStatus::I2C_OK);
+    ASSERT_from_sampleOut_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(0).timeUs, 2000);
+
+    this->invoke_to_dataReady(0, 4000);
+    this->completeJob(1, Drv::I2cStatus::I2C_OK);
+    ASSERT_from_sampleOut_SIZE(2);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(1).timeUs, 4000);
+
+    // a read that fails publishes nothing, the next edge queues a read of its own
+    this->invoke_to_dataReady(0, 5000);
+    this->completeJob(2, Drv::I2cStatus::I2C_OTHER_ERR);
+    ASSERT_from_sampleOut_SIZE(2);
+    ASSERT_TLM_readErrors_SIZE(1);
+    this->invoke_to_dataReady(0, 6000);
+    ASSERT_from_jobOut_SIZE(4);
+    this->completeJob(3, Drv::I2cStatus::I2C_OK);
+    ASSERT_from_sampleOut_SIZE(3);
+    ASSERT_EQ(this->fromPortHistory_sampleOut->at(2).timeUs, 6000);
+  }
+
+
+  void AccelGyroTester ::
+    testDataReadyBackoff()
+  {
+    this->paramSet_MAX_BACKOFF_TICKS(4, Fw::ParamValid::VALID);
+    this->paramSend_MAX_BACKOFF_TICKS(0, 0);
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::DATA_READY);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->m_readStatus = Drv::I2cStatus::I2C_OTHER_ERR;
+
+    // failed reads under the threshold leave the next edge to read again
+    this->clearHistory();
+    this->clearFromPortHistory();
+    for (U32 i = 0; i < 3; i++) {
+      this->invoke_to_dataReady(0, 1000 * (i + 1));
+    }
+    ASSERT_from_writeRead_SIZE(3);
+    ASSERT_TLM_accelerometer_SIZE(0);
+    ASSERT_EVENTS_BusBackoff_SIZE(1);
+    ASSERT_EVENTS_BusBackoff(0, 3, 1);
+
+    // edges during the backoff are skipped however many come, the ticks count it down
+    this->clearFromPortHistory();
+    for (U32 i = 0; i < 5; i++) {
+      this->invoke_to_dataReady(0, 4000 + 1000 * i);
+    }
+    ASSERT_from_writeRead_SIZE(0);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_writeRead_SIZE(0);
+    this->invoke_to_dataReady(0, 9000);
+    ASSERT_from_writeRead_SIZE(1);
+
+    // that read failed too and backs off for two ticks, then the bus answers and acquisition resumes
+    this->m_readStatus = Drv::I2cStatus::I2C_OK;
+    this->clearHistory();
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    this->invoke_to_dataReady(0, 10000);
+    ASSERT_from_writeRead_SIZE(0);
+    this->invoke_to_Run(0, 0);
+    this->invoke_to_dataReady(0, 11000);
+    this->invoke_to_dataReady(0, 12000);
+    ASSERT_from_writeRead_SIZE(2);
+    ASSERT_EVENTS_BusRecovered_SIZE(1);
+    ASSERT_EVENTS_BusRecovered(0, 4);
+    ASSERT_TLM_accelerometer_SIZE(2);
+  }
+
+
+  void AccelGyroTester ::
+    testStageLatency()
+  {
+    const U32 ticks = 3;
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    for (U32 i = 0; i < ticks; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    this->invoke_to_latencyRun(0, 0);
+    if (!AccelGyro::TickProfiler::ENABLED) {
+      // built without profiling there is nothing to report
+      ASSERT_TLM_tickLatency_SIZE(0);
+      return;
+    }
+
+    // a register tick has one read, one decode and one publish
+    ASSERT_TLM_tickLatency_SIZE(1);
+    this->checkLatency(this->tlmHistory_busLatency->at(0).arg, ticks);
+    this->checkLatency(this->tlmHistory_decodeLatency->at(0).arg, ticks);
+    this->checkLatency(this->tlmHistory_publishLatency->at(0).arg, ticks);
+    this->checkLatency(this->tlmHistory_tickLatency->at(0).arg, ticks);
+
+    // an empty FIFO ends the tick after the count read, both reads of a drain are one bus time
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->invoke_to_Run(0, 0);
+    this->m_fifoCount = 2 * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    this->invoke_to_latencyRun(0, 0);
+    this->checkLatency(this->tlmHistory_busLatency->at(1).arg, ticks + 2);
+    this->checkLatency(this->tlmHistory_decodeLatency->at(1).arg, ticks + 1);
+    this->checkLatency(this->tlmHistory_publishLatency->at(1).arg, ticks + 1);
+    this->checkLatency(this->tlmHistory_tickLatency->at(1).arg, ticks + 2);
+
+    // reset clears every stage
+    this->sendCmd_RESET_LATENCY(0, 0);
+    ASSERT_CMD_RESPONSE(2, AccelGyro::OPCODE_RESET_LATENCY, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_LatencyReset_SIZE(1);
+    this->invoke_to_latencyRun(0, 0);
+    this->checkLatency(this->tlmHistory_busLatency->at(2).arg, 0);
+    this->checkLatency(this->tlmHistory_tickLatency->at(2).arg, 0);
+  }
+
+
   void AccelGyroTester ::
     testPowerOnOff()
   {
@@ -121,16 +1022,113 @@ namespace Components {
     ASSERT_EVENTS_PowerModeError_SIZE(1);
     ASSERT_EVENTS_ConfigError_SIZE(0);
     ASSERT_EVENTS_PowerModeError(0, this->m_writeStatus);
+    ASSERT_TLM_writeErrors(0, 1);
+
+    // the command fails, only the earlier power off is reported
+    ASSERT_EVENTS_PowerState_SIZE(1);
+    ASSERT_EVENTS_PowerState(0, Fw::On::OFF);
+    ASSERT_CMD_RESPONSE_SIZE(2);
+    ASSERT_CMD_RESPONSE(1, AccelGyro::OPCODE_POWER_ON_OFF, 0, Fw::CmdResponse::EXECUTION_ERROR);
   }
 
 
   void AccelGyroTester ::
     testSetupError()
   {
+    // power goes through, the configuration burst and the interrupt enable write do not
     this->m_writeStatus = Drv::I2cStatus::I2C_ADDRESS_ERR;
     this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
-    ASSERT_EVENTS_ConfigError_SIZE(2);
+    ASSERT_EVENTS_ConfigError_SIZE(1);
     ASSERT_EVENTS_ConfigError(0, this->m_writeStatus);
+    ASSERT_TLM_writeErrors_SIZE(2);
+    ASSERT_TLM_writeErrors(1, 2);
+
+    // registers that failed are unknown, so they are written again even though the values have not changed
+    this->m_writeStatus = Drv::I2cStatus::I2C_OK;
+    this->clearFromPortHistory();
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_from_write_SIZE(2);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_184HZ);
+  }
+
+
+  void AccelGyroTester ::
+    testRegisterShadow()
+  {
+    const U8 powerOn = AccelGyro::POWER_ON;
+    const U8 powerAddr = AccelGyro::POWER_MGMT_ADDR;
+    const U8 sampleRateAddr = AccelGyro::SMPLRT_DIV_ADDR;
+    const U8 configAddr = AccelGyro::DEVICE_CONFIG_ADDR;
+
+    // a cold power on writes PWR_MGMT_1, SMPLRT_DIV..ACCEL_CONFIG in one burst and INT_PIN_CFG..INT_ENABLE in another
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_from_write_SIZE(3);
+    ASSERT_EQ(this->m_writes[1].size, 5);
+    ASSERT_EQ(this->m_writes[1].address, sampleRateAddr);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::POWER_MGMT_ADDR], powerOn);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_184HZ);
+
+    // and the whole window is read back once
+    const U32 window = AccelGyro::ConfigShadow::SPAN;
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_writeRead->at(0).readBuffer.getSize(), window);
+    ASSERT_EVENTS_ConfigMismatch_SIZE(0);
+
+    // a warm restart only writes the power state
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+    this->clearFromPortHistory();
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_from_write_SIZE(1);
+    ASSERT_EQ(this->m_writes[0].address, powerAddr);
+    ASSERT_from_writeRead_SIZE(1);
+
+    // a parameter set to the value the device holds is not written
+    this->clearFromPortHistory();
+    this->paramSet_SAMPLE_RATE_DIVIDER(0, Fw::ParamValid::VALID);
+    this->paramSend_SAMPLE_RATE_DIVIDER(0, 0);
+    ASSERT_from_write_SIZE(0);
+
+    // a brown-out puts the device back to its reset values, powering on again finds and repairs them
+    memset(this->writtenRegs, 0, sizeof this->writtenRegs);
+    this->writtenRegs[AccelGyro::POWER_MGMT_ADDR] = AccelGyro::POWER_OFF;
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EVENTS_ConfigMismatch_SIZE(1);
+    ASSERT_EVENTS_ConfigMismatch(0, configAddr, 0, Components::DlpfBandwidth::BW_184HZ, 2);
+    ASSERT_TLM_configMismatches(0, 2);
+    ASSERT_from_write_SIZE(2);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_184HZ);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::POWER_MGMT_ADDR], powerOn);
+  }
+
+
+  void AccelGyroTester ::
+    testSampleRateParams()
+  {
+    // defaults are applied at power on
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::SMPLRT_DIV_ADDR], 0);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_184HZ);
+
+    // a powered device picks up new values as soon as they are set
+    this->paramSet_SAMPLE_RATE_DIVIDER(9, Fw::ParamValid::VALID);
+    this->paramSend_SAMPLE_RATE_DIVIDER(0, 0);
+    ASSERT_CMD_RESPONSE(1, AccelGyro::OPCODE_SAMPLE_RATE_DIVIDER_SET, 0, Fw::CmdResponse::OK);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::SMPLRT_DIV_ADDR], 9);
+
+    this->paramSet_DLPF_BANDWIDTH(Components::DlpfBandwidth::BW_44HZ, Fw::ParamValid::VALID);
+    this->paramSend_DLPF_BANDWIDTH(0, 0);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_44HZ);
+
+    // an unpowered device is left alone until the next power on
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::OFF);
+    this->clearFromPortHistory();
+    this->paramSet_SAMPLE_RATE_DIVIDER(4, Fw::ParamValid::VALID);
+    this->paramSend_SAMPLE_RATE_DIVIDER(0, 0);
+    ASSERT_from_write_SIZE(0);
+
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::SMPLRT_DIV_ADDR], 4);
+    ASSERT_EQ(this->writtenRegs[AccelGyro::DEVICE_CONFIG_ADDR], Components::DlpfBandwidth::BW_44HZ);
   }
 
 
@@ -145,9 +1143,454 @@ namespace Components {
     this->m_readStatus = Drv::I2cStatus::I2C_OTHER_ERR;
     this->m_writeStatus = Drv::I2cStatus::I2C_OTHER_ERR;
     this->invoke_to_Run(0, 0);
-    ASSERT_EVENTS_TelemetryError_SIZE(2);
-    ASSERT_EVENTS_TelemetryError(0, this->m_readStatus);
-    ASSERT_EVENTS_TelemetryError(0, this->m_readStatus);
+    ASSERT_EVENTS_TelemetryError_SIZE(1);
+    ASSERT_EVENTS_TelemetryError(0, this->m_readStatus, 1);
+    ASSERT_TLM_readErrors(0, 1);
+    ASSERT_TLM_consecutiveFailures(0, 1);
+  }
+
+
+  void AccelGyroTester ::
+    testDeadband()
+  {
+    // nothing the default range can read is 100 g or 10000 deg/s away from the first sample
+    this->paramSet_ACCEL_DEADBAND(100.0f, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_DEADBAND(0, 0);
+    this->paramSet_GYRO_DEADBAND(10000.0f, Fw::ParamValid::VALID);
+    this->paramSend_GYRO_DEADBAND(0, 0);
+    this->paramSet_TLM_HEARTBEAT(3, Fw::ParamValid::VALID);
+    this->paramSend_TLM_HEARTBEAT(0, 0);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+
+    // the first sample after power on always goes, then one in every three
+    this->clearHistory();
+    for (U32 i = 0; i < 7; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_TLM_temperature_SIZE(7);
+    ASSERT_TLM_accelerometer_SIZE(3);
+    ASSERT_TLM_gyroscope_SIZE(3);
+
+    // without a heartbeat a held value waits for a change
+    this->paramSet_TLM_HEARTBEAT(0, Fw::ParamValid::VALID);
+    this->paramSend_TLM_HEARTBEAT(0, 0);
+    this->clearHistory();
+    for (U32 i = 0; i < 7; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_gyroscope_SIZE(1);
+
+    // each channel has its own deadband, 0 sends every sample
+    this->paramSet_GYRO_DEADBAND(0.0f, Fw::ParamValid::VALID);
+    this->paramSend_GYRO_DEADBAND(0, 0);
+    this->clearHistory();
+    for (U32 i = 0; i < 4; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_TLM_accelerometer_SIZE(1);
+    ASSERT_TLM_gyroscope_SIZE(4);
+  }
+
+
+  void AccelGyroTester ::
+    testRawTelemetry()
+  {
+    this->paramSet_ACCEL_TLM_FORMAT(Components::TlmFormat::RAW, Fw::ParamValid::VALID);
+    this->paramSend_ACCEL_TLM_FORMAT(0, 0);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+
+    // the range goes down with the configuration so the ground can scale the counts
+    ASSERT_TLM_accelRange_SIZE(1);
+    ASSERT_TLM_accelRange(0, Components::AccelRange::G2);
+    ASSERT_TLM_gyroRange(0, Components::GyroRange::DPS250);
+
+    // each channel has its own format
+    this->invoke_to_Run(0, 0);
+    I16 raw[AccelGyro::MAX_DATA_SIZE / 2];
+    for (U32 j = 0; j < AccelGyro::MAX_DATA_SIZE / 2; j++) {
+      EXPECT_EQ(this->sampleSerBuf.deserialize(raw[j]), Fw::FW_SERIALIZE_OK);
+    }
+    ASSERT_TLM_accelerometer_SIZE(0);
+    ASSERT_TLM_accelerometerRaw_SIZE(1);
+    ASSERT_TLM_accelerometerRaw(0, Components::I16x3(raw[0], raw[1], raw[2]));
+    ASSERT_TLM_gyroscopeRaw_SIZE(0);
+    ASSERT_TLM_gyroscope_SIZE(1);
+    ASSERT_TLM_gyroscope(0, Components::F32x3(static_cast<F32>(raw[4]) / AccelGyro::gyroScaleFactor,
+                                              static_cast<F32>(raw[5]) / AccelGyro::gyroScaleFactor,
+                                              static_cast<F32>(raw[6]) / AccelGyro::gyroScaleFactor));
+
+    // a filtered output is rounded back to whole counts
+    this->paramSet_GYRO_TLM_FORMAT(Components::TlmFormat::RAW, Fw::ParamValid::VALID);
+    this->paramSend_GYRO_TLM_FORMAT(0, 0);
+    this->paramSet_DECIMATION_FILTER(Components::DecimationFilter::MOVING_AVERAGE, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_FILTER(0, 0);
+    this->paramSet_DECIMATION_RATIO(2, Fw::ParamValid::VALID);
+    this->paramSend_DECIMATION_RATIO(0, 0);
+    this->clearHistory();
+    I16 first[AccelGyro::MAX_DATA_SIZE / 2];
+    I16 second[AccelGyro::MAX_DATA_SIZE / 2];
+    this->invoke_to_Run(0, 0);
+    for (U32 j = 0; j < AccelGyro::MAX_DATA_SIZE / 2; j++) {
+      EXPECT_EQ(this->sampleSerBuf.deserialize(first[j]), Fw::FW_SERIALIZE_OK);
+    }
+    this->invoke_to_Run(0, 0);
+    for (U32 j = 0; j < AccelGyro::MAX_DATA_SIZE / 2; j++) {
+      EXPECT_EQ(this->sampleSerBuf.deserialize(second[j]), Fw::FW_SERIALIZE_OK);
+    }
+    ASSERT_TLM_accelerometerRaw_SIZE(1);
+    ASSERT_TLM_gyroscopeRaw_SIZE(1);
+    ASSERT_TLM_gyroscope_SIZE(0);
+    const I16x3 gyroCounts = this->tlmHistory_gyroscopeRaw->at(0).arg;
+    for (U32 j = 0; j < 3; j++) {
+      const F32 mean = (static_cast<F32>(first[4 + j]) + static_cast<F32>(second[4 + j])) / 2.0f;
+      EXPECT_NEAR(static_cast<F32>(gyroCounts[j]), mean, 0.5f);
+    }
+  }
+
+
+  void AccelGyroTester ::
+    testSampleRing()
+  {
+    typedef SampleRing<8> TestRing;
+    TestRing ring;
+    RingSample out[16];
+    const F32 accel[3] = {1.0f, 2.0f, 3.0f};
+    const F32 gyro[3] = {4.0f, 5.0f, 6.0f};
+
+    // a batch is seen whole once committed, by every reader
+    TestRing::Reader first(ring);
+    ring.begin(3);
+    for (U64 t = 0; t < 3; t++) {
+      ring.put(accel, gyro, t);
+    }
+    ASSERT_EQ(first.read(out, 16), 0U);
+    ring.commit();
+    TestRing::Reader late(ring);
+    ASSERT_EQ(late.available(), 0U);
+    ASSERT_EQ(first.read(out, 2), 2U);
+    ASSERT_EQ(out[1].timeUs, 1U);
+    ASSERT_EQ(out[1].gyro[2], 6.0f);
+    ASSERT_EQ(first.read(out, 16), 1U);
+    ASSERT_EQ(out[0].timeUs, 2U);
+
+    // a reader that falls a ring behind skips to the oldest sample left and counts the rest
+    TestRing::Reader slow(ring);
+    for (U64 t = 3; t < 23; t++) {
+      ring.begin(1);
+      ring.put(accel, gyro, t);
+      ring.commit();
+    }
+    ASSERT_EQ(slow.available(), 20U);
+    ASSERT_EQ(slow.read(out, 16), 8U);
+    ASSERT_EQ(slow.overruns(), 12U);
+    ASSERT_EQ(out[0].timeUs, 15U);
+    ASSERT_EQ(first.read(out, 16), 8U);
+    ASSERT_EQ(first.overruns(), 12U);
+
+    // readers on other threads see every sample in order and whole, or count it as lost
+    static AccelGyro::ImuSampleRing shared;
+    const U64 total = 200000;
+    const U64 start = shared.written();
+    std::atomic<bool> done(false);
+    std::atomic<U32> attached(0);
+    auto consume = [&](U64& got, U64& lost, bool& ordered) {
+      AccelGyro::ImuSampleRing::Reader reader(shared);
+      attached++;
+      RingSample batch[64];
+      U64 last = start;
+      while (!done.load() || (reader.available() > 0)) {
+        const FwSizeType n = reader.read(batch, 64);
+        for (FwSizeType i = 0; i < n; i++) {
+          const RingSample& s = batch[i];
+          ordered = ordered && (s.timeUs > last) && (s.accel[0] == static_cast<F32>(s.timeUs)) &&
+                    (s.gyro[2] == -static_cast<F32>(s.timeUs));
+          last = s.timeUs;
+        }
+        got += n;
+        if (n == 0) {
+          std::this_thread::yield();
+        }
+      }
+      lost = reader.overruns();
+    };
+    U64 got[2] = {0, 0};
+    U64 lost[2] = {0, 0};
+    bool ordered[2] = {true, true};
+    std::thread readers[2] = {std::thread(consume, std::ref(got[0]), std::ref(lost[0]), std::ref(ordered[0])),
+                              std::thread(consume, std::ref(got[1]), std::ref(lost[1]), std::ref(ordered[1]))};
+    // readers attach before the first sample so every one is either read or lost
+    while (attached.load() < 2) {
+      std::this_thread::yield();
+    }
+    for (U64 t = start + 1; t <= start + total; t += 4) {
+      shared.begin(4);
+      for (U64 k = 0; k < 4; k++) {
+        const F32 value = static_cast<F32>(t + k);
+        const F32 a[3] = {value, 0.0f, 0.0f};
+        const F32 g[3] = {0.0f, 0.0f, -value};
+        shared.put(a, g, t + k);
+      }
+      shared.commit();
+    }
+    done.store(true);
+    for (U32 r = 0; r < 2; r++) {
+      readers[r].join();
+      ASSERT_TRUE(ordered[r]);
+      ASSERT_EQ(got[r] + lost[r], total);
+    }
+  }
+
+
+  void AccelGyroTester ::
+    testSampleRingPublish()
+  {
+    AccelGyro::ImuSampleRing ring;
+    AccelGyro::ImuSampleRing::Reader reader(ring);
+    this->component.setSampleRing(&ring);
+    this->setTestTime(Fw::Time(TB_NONE, 100, 500000));
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+
+    // a register read is one sample, in the units telemetry uses
+    this->invoke_to_Run(0, 0);
+    RingSample out[AccelGyro::FIFO_MAX_FRAMES];
+    ASSERT_EQ(reader.read(out, AccelGyro::FIFO_MAX_FRAMES), 1U);
+    I16 raw[AccelGyro::MAX_DATA_SIZE / 2];
+    for (U32 j = 0; j < AccelGyro::MAX_DATA_SIZE / 2; j++) {
+      EXPECT_EQ(this->sampleSerBuf.deserialize(raw[j]), Fw::FW_SERIALIZE_OK);
+    }
+    for (U32 j = 0; j < 3; j++) {
+      ASSERT_EQ(out[0].accel[j], static_cast<F32>(raw[j]) / AccelGyro::accelScaleFactor);
+      ASSERT_EQ(out[0].gyro[j], static_cast<F32>(raw[4 + j]) / AccelGyro::gyroScaleFactor);
+    }
+
+    // a drain is one batch, frames a sample period apart ending at the newest
+    const U32 frames = 5;
+    this->sendCmd_SET_ACQUISITION_MODE(0, 0, Components::AcquisitionMode::FIFO);
+    this->m_fifoCount = frames * AccelGyro::FIFO_FRAME_SIZE;
+    this->invoke_to_Run(0, 0);
+    ASSERT_EQ(reader.read(out, AccelGyro::FIFO_MAX_FRAMES), frames);
+    for (U32 i = 1; i < frames; i++) {
+      ASSERT_EQ(out[i].timeUs - out[i - 1].timeUs, AccelGyro::GYRO_PERIOD_US_DLPF_ON);
+    }
+    I16 frame[6];
+    for (U32 j = 0; j < 6; j++) {
+      EXPECT_EQ(this->fifoSerBuf.deserialize(frame[j]), Fw::FW_SERIALIZE_OK);
+    }
+    ASSERT_EQ(out[0].accel[0], static_cast<F32>(frame[0]) / AccelGyro::accelScaleFactor);
+    ASSERT_EQ(out[0].gyro[2], static_cast<F32>(frame[5]) / AccelGyro::gyroScaleFactor);
+    ASSERT_EQ(reader.overruns(), 0U);
+
+    this->component.setSampleRing(nullptr);
+  }
+
+
+  void AccelGyroTester ::
+    testBusBackoff()
+  {
+    this->paramSet_MAX_BACKOFF_TICKS(4, Fw::ParamValid::VALID);
+    this->paramSend_MAX_BACKOFF_TICKS(0, 0);
+    this->sendCmd_POWER_ON_OFF(0, 0, Fw::On::ON);
+    this->m_readStatus = Drv::I2cStatus::I2C_OTHER_ERR;
+
+    // failures under the threshold are retried every tick
+    this->clearHistory();
+    this->clearFromPortHistory();
+    for (U32 i = 0; i < 3; i++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_from_writeRead_SIZE(3);
+    ASSERT_EVENTS_TelemetryError_SIZE(3);
+    ASSERT_EVENTS_TelemetryError(2, Drv::I2cStatus::I2C_OTHER_ERR, 3);
+    ASSERT_EVENTS_BusBackoff_SIZE(1);
+    ASSERT_EVENTS_BusBackoff(0, 3, 1);
+    ASSERT_TLM_readErrors(2, 3);
+    ASSERT_TLM_consecutiveFailures(2, 3);
+
+    // the gap doubles with every failure past the threshold up to MAX_BACKOFF_TICKS, and the error event is throttled
+    // after five
+    const U16 gaps[] = {1, 2, 4, 4};
+    for (U32 i = 0; i < 4; i++) {
+      const U32 failures = 4 + i;
+      this->clearHistory();
+      this->clearFromPortHistory();
+      for (U16 k = 0; k < gaps[i]; k++) {
+        this->invoke_to_Run(0, 0);
+      }
+      ASSERT_from_writeRead_SIZE(0);
+      this->invoke_to_Run(0, 0);
+      ASSERT_from_writeRead_SIZE(1);
+      ASSERT_EVENTS_TelemetryError_SIZE((failures <= 5) ? 1 : 0);
+      ASSERT_EVENTS_BusBackoff_SIZE(1);
+      ASSERT_EVENTS_BusBackoff(0, failures, (i == 0) ? 2 : 4);
+      ASSERT_TLM_readErrors(0, failures);
+    }
+
+    // the throttle is lifted by command, the counters were never throttled
+    this->clearHistory();
+    this->clearFromPortHistory();
+    this->sendCmd_RESET_ERROR_THROTTLE(0, 0);
+    ASSERT_CMD_RESPONSE(0, AccelGyro::OPCODE_RESET_ERROR_THROTTLE, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_ErrorThrottleReset_SIZE(1);
+    for (U32 k = 0; k < 5; k++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EVENTS_TelemetryError_SIZE(1);
+    ASSERT_EVENTS_TelemetryError(0, Drv::I2cStatus::I2C_OTHER_ERR, 8);
+
+    // one good read ends the backoff
+    this->m_readStatus = Drv::I2cStatus::I2C_OK;
+    this->clearHistory();
+    this->clearFromPortHistory();
+    for (U32 k = 0; k < 5; k++) {
+      this->invoke_to_Run(0, 0);
+    }
+    ASSERT_from_writeRead_SIZE(1);
+    ASSERT_EVENTS_BusRecovered_SIZE(1);
+    ASSERT_EVENTS_BusRecovered(0, 8);
+    ASSERT_TLM_consecutiveFailures(0, 0);
+    ASSERT_TLM_accelerometer_SIZE(1);
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_writeRead_SIZE(2);
+    ASSERT_EVENTS_BusRecovered_SIZE(1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void AccelGyroTester ::
+    checkFifoReset(U32 first)
+  {
+    const U8 fifoEnAddr = AccelGyro::FIFO_EN_ADDR;
+    const U8 userCtrlAddr = AccelGyro::USER_CTRL_ADDR;
+    const U8 expected[][2] = {
+      {fifoEnAddr, 0},
+      {userCtrlAddr, 0},
+      {userCtrlAddr, AccelGyro::USER_CTRL_FIFO_RESET},
+      {userCtrlAddr, AccelGyro::USER_CTRL_FIFO_EN},
+      {fifoEnAddr, AccelGyro::FIFO_EN_ACCEL_GYRO}
+    };
+    ASSERT_GE(this->fromPortHistory_write->size(), first + FW_NUM_ARRAY_ELEMENTS(expected));
+    for (U32 i = 0; i < FW_NUM_ARRAY_ELEMENTS(expected); i++) {
+      const WriteRecord& write = this->m_writes[first + i];
+      ASSERT_EQ(write.size, 2);
+      ASSERT_EQ(write.address, expected[i][0]);
+      ASSERT_EQ(write.value, expected[i][1]);
+    }
+  }
+
+  void AccelGyroTester ::
+    checkSampleTlm(U32 index, F32 accelScaleFactor, F32 gyroScaleFactor)
+  {
+    I16 raw[AccelGyro::MAX_DATA_SIZE / 2];
+    for (U32 j = 0; j < AccelGyro::MAX_DATA_SIZE / 2; j++) {
+      EXPECT_EQ(this->sampleSerBuf.deserialize(raw[j]), Fw::FW_SERIALIZE_OK);
+    }
+
+    // accel x/y/z, temperature, gyro x/y/z
+    const Components::F32x3 expectedAccel(static_cast<F32>(raw[0]) / accelScaleFactor,
+                                          static_cast<F32>(raw[1]) / accelScaleFactor,
+                                          static_cast<F32>(raw[2]) / accelScaleFactor);
+    const Components::F32x3 expectedGyro(static_cast<F32>(raw[4]) / gyroScaleFactor,
+                                         static_cast<F32>(raw[5]) / gyroScaleFactor,
+                                         static_cast<F32>(raw[6]) / gyroScaleFactor);
+    ASSERT_TLM_accelerometer(index, expectedAccel);
+    ASSERT_TLM_gyroscope(index, expectedGyro);
+  }
+
+  void AccelGyroTester ::
+    checkLatency(const StageLatency& latency, U32 count)
+  {
+    // struct members are read back through their serialized form
+    U8 bytes[StageLatency::SERIALIZED_SIZE];
+    Fw::SerialBuffer serBuf(bytes, sizeof bytes);
+    ASSERT_EQ(serBuf.serialize(latency), Fw::FW_SERIALIZE_OK);
+
+    U32 timed = 0;
+    U32 p99Ns = 0;
+    U32 maxNs = 0;
+    LatencyBuckets buckets;
+    ASSERT_EQ(serBuf.deserialize(timed), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(serBuf.deserialize(p99Ns), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(serBuf.deserialize(maxNs), Fw::FW_SERIALIZE_OK);
+    ASSERT_EQ(serBuf.deserialize(buckets), Fw::FW_SERIALIZE_OK);
+
+    ASSERT_EQ(timed, count);
+    ASSERT_LE(p99Ns, maxNs);
+    U32 total = 0;
+    for (U32 b = 0; b < LatencyBuckets::SIZE; b++) {
+      total += buckets[b];
+    }
+    ASSERT_EQ(total, count);
+    if (count > 0) {
+      // the maximum sits in the last bucket with anything in it
+      FwSizeType last = LatencyBuckets::SIZE - 1;
+      while (buckets[last] == 0) {
+        last--;
+      }
+      ASSERT_EQ(AccelGyro::TickProfiler::bucket(maxNs), last);
+    }
+  }
+
+
+  void AccelGyroTester ::
+    completeJob(U32 index, Drv::I2cStatus status)
+  {
+    const U32 context = this->fromPortHistory_jobOut->at(index).context;
+    const U32 addr = this->fromPortHistory_jobOut->at(index).addr;
+    Fw::Buffer writeBuffer(this->fromPortHistory_jobOut->at(index).writeBuffer);
+    Fw::Buffer readBuffer(this->fromPortHistory_jobOut->at(index).readBuffer);
+
+    // run the job through the same bus model as the synchronous ports
+    if (status == Drv::I2cStatus::I2C_OK) {
+      EXPECT_EQ(this->from_writeRead_handler(0, addr, writeBuffer, readBuffer), Drv::I2cStatus::I2C_OK);
+    }
+    this->invoke_to_jobDone(0, context, status, readBuffer);
+  }
+
+  void AccelGyroTester ::
+    connectPorts()
+  {
+    this->connect_to_Run(0, this->component.get_Run_InputPort(0));
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+    this->connect_to_jobDone(0, this->component.get_jobDone_InputPort(0));
+    this->connect_to_latencyRun(0, this->component.get_latencyRun_InputPort(0));
+    this->connect_to_dataReady(0, this->component.get_dataReady_InputPort(0));
+
+    this->component.set_writeRead_OutputPort(0, this->get_from_writeRead(0));
+    this->component.set_write_OutputPort(0, this->get_from_write(0));
+    if (this->m_busManager) {
+      this->component.set_jobOut_OutputPort(0, this->get_from_jobOut(0));
+    }
+    if (this->m_recorder) {
+      this->component.set_recordAllocate_OutputPort(0, this->get_from_recordAllocate(0));
+      this->component.set_recordOut_OutputPort(0, this->get_from_recordOut(0));
+    }
+    if (this->m_batcher) {
+      this->component.set_batchOut_OutputPort(0, this->get_from_batchOut(0));
+    }
+    if (this->m_sampler) {
+      this->component.set_sampleOut_OutputPort(0, this->get_from_sampleOut(0));
+    }
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+#if FW_ENABLE_TEXT_LOGGING == 1
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+#endif
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+    this->component.set_prmGetOut_OutputPort(0, this->get_from_prmGetOut(0));
+    this->component.set_prmSetOut_OutputPort(0, this->get_from_prmSetOut(0));
+  }
+
+  void AccelGyroTester ::
+    initComponents()
+  {
+    this->init();
+    this->component.init(AccelGyroTester::TEST_INSTANCE_ID);
   }
 
   // ----------------------------------------------------------------------
@@ -155,16 +1598,20 @@ namespace Components {
   // ----------------------------------------------------------------------
 
   Drv::I2cStatus AccelGyroTester::
-    from_read_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& serBuffer) 
+    from_writeRead_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& writeBuffer, Fw::Buffer& readBuffer)
   {
-    this->pushFromPortEntry_read(addr, serBuffer);
+    this->pushFromPortEntry_writeRead(addr, writeBuffer, readBuffer);
     EXPECT_EQ(addr, ADDRESS_TEST);
 
+    // the write half of the transaction sets the register pointer
+    EXPECT_EQ(writeBuffer.getSize(), 1);
+    this->addrBuf = writeBuffer.getData()[0];
+
     if (this->m_readStatus == Drv::I2cStatus::I2C_OK) {
       // fill buffer with random data
-      U8* const data = serBuffer.getData();
-      const U32 size = serBuffer.getSize();
-      const U32 accelGyro_max_data_size = AccelGyro::MAX_DATA_SIZE;
+      U8* const data = readBuffer.getData();
+      const U32 size = readBuffer.getSize();
+      const U32 accelGyro_max_data_size = FIFO_BUF_SIZE_BYTES;
 
       EXPECT_LE(size, accelGyro_max_data_size);
 
@@ -174,19 +1621,35 @@ namespace Components {
         data[i] = byte;
       }
 
-      if (this->addrBuf == AccelGyro::ACCEL_RAW_DATA_START) {
-        // Address write is the accelerometer register
-        // so copy data into that buffer
-        this->accelSerBuf.resetSer();
-        const auto status = this->accelSerBuf.pushBytes(&data[0], size);
+      if (this->addrBuf == AccelGyro::SAMPLE_DATA_START) {
+        // Address write is the start of the accel/temp/gyro block
+        // so copy data into the sample buffer
+        this->sampleSerBuf.resetSer();
+        const auto status = this->sampleSerBuf.pushBytes(&data[0], size);
         EXPECT_EQ(status, Fw::FW_SERIALIZE_OK);
       }
 
-      if (this->addrBuf == AccelGyro::GYRO_RAW_DATA_START) {
-        // Address write was the gyroscope register
-        // so copy data into that buffer
-        this->gyroSerBuf.resetSer();
-        const auto status = this->gyroSerBuf.pushBytes(&data[0], size);
+      if (this->addrBuf == AccelGyro::ConfigShadow::FIRST_ADDR) {
+        // Address write was the start of the configuration registers
+        // so read back what was written to them
+        EXPECT_EQ(size, static_cast<U32>(AccelGyro::ConfigShadow::SPAN));
+        memcpy(data, &this->writtenRegs[this->addrBuf], size);
+      }
+
+      if (this->addrBuf == AccelGyro::FIFO_COUNT_H_ADDR) {
+        // Address write was the FIFO count so report the configured count, a disabled FIFO queues nothing
+        EXPECT_EQ(size, 2);
+        const bool enabled = (this->writtenRegs[AccelGyro::USER_CTRL_ADDR] & AccelGyro::USER_CTRL_FIFO_EN) != 0;
+        const U16 count = enabled ? this->m_fifoCount : 0;
+        data[0] = static_cast<U8>(count >> 8);
+        data[1] = static_cast<U8>(count & 0xFF);
+      }
+
+      if (this->addrBuf == AccelGyro::FIFO_R_W_ADDR) {
+        // Address write was the FIFO data register
+        // so copy data into the FIFO buffer
+        this->fifoSerBuf.resetSer();
+        const auto status = this->fifoSerBuf.pushBytes(&data[0], size);
         EXPECT_EQ(status, Fw::FW_SERIALIZE_OK);
       }
     }
@@ -195,9 +1658,25 @@ namespace Components {
   }
 
 
+  Fw::Buffer AccelGyroTester::
+    from_recordAllocate_handler(const NATIVE_INT_TYPE portNum, U32 size)
+  {
+    this->pushFromPortEntry_recordAllocate(size);
+    if (!this->m_chunkAvailable) {
+      return Fw::Buffer();
+    }
+
+    EXPECT_EQ(size, RawRecord::CHUNK_SIZE);
+    U8* const data = this->m_chunkBufs[this->m_chunkIndex];
+    this->m_chunkIndex = (this->m_chunkIndex + 1) % 2;
+    return Fw::Buffer(data, size);
+  }
+
+
   Drv::I2cStatus AccelGyroTester::
     from_write_handler(const NATIVE_INT_TYPE portNum, U32 addr, Fw::Buffer& serBuffer)
   {
+    const FwSizeType index = this->fromPortHistory_write->size();
     this->pushFromPortEntry_write(addr, serBuffer);
     EXPECT_EQ(addr, ADDRESS_TEST);
 
@@ -206,10 +1685,19 @@ namespace Components {
 
     U8* const data = (U8*)serBuffer.getData();
     Drv::I2cStatus status = Drv::I2cStatus::I2C_OK;
+    if ((index < MAX_HISTORY_SIZE) && (size > 0)) {
+      this->m_writes[index].address = data[0];
+      this->m_writes[index].value = (size > 1) ? data[1] : 0;
+      this->m_writes[index].size = size;
+    }
 
-    if (size == 1) {
-      // address write so store the address in the address buffer
-      this->addrBuf = data[0];
+    // first byte is the register pointer, the device auto-increments through any bytes after it
+    this->addrBuf = data[0];
+    for (U32 i = 1; i < size; i++) {
+      EXPECT_LT(data[0] + i - 1, NUM_REGISTERS);
+      if ((data[0] + i - 1) < NUM_REGISTERS) {
+        this->writtenRegs[data[0] + i - 1] = data[i];
+      }
     }
 
     if (this->m_writeStatus == Drv::I2cStatus::I2C_ADDRESS_ERR) {
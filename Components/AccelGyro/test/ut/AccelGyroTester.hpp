@@ -26,12 +26,37 @@ namespace Components {
 
       static constexpr U16 READ_BUF_SIZE_BYTES = AccelGyro::MAX_DATA_SIZE;
 
+      static constexpr U16 FIFO_BUF_SIZE_BYTES = AccelGyro::FIFO_MAX_FRAMES * AccelGyro::FIFO_FRAME_SIZE;
+
+      // Number of device registers tracked by the write handler
+      static constexpr U16 NUM_REGISTERS = 128;
+
       // Maximum size of histories storing events, telemetry, and port outputs
       static const FwSizeType MAX_HISTORY_SIZE = 10;
 
       // Instance ID supplied to the component instance under test
       static const FwEnumStoreType TEST_INSTANCE_ID = 0;
 
+      //! Optional ports a test wires beyond the ones every test has, named at the call site:
+      //! AccelGyroTester tester(AccelGyroTester::Wiring().busManager().sampler());
+      struct Wiring {
+        Wiring() : m_busManager(false), m_recorder(false), m_batcher(false), m_sampler(false) {}
+
+        //! connect jobOut so reads are queued with a bus manager
+        Wiring& busManager() { this->m_busManager = true; return *this; }
+        //! connect the recording ports
+        Wiring& recorder() { this->m_recorder = true; return *this; }
+        //! connect batchOut
+        Wiring& batcher() { this->m_batcher = true; return *this; }
+        //! connect sampleOut
+        Wiring& sampler() { this->m_sampler = true; return *this; }
+
+        bool m_busManager;
+        bool m_recorder;
+        bool m_batcher;
+        bool m_sampler;
+      };
+
     public:
 
       // ----------------------------------------------------------------------
@@ -39,7 +64,7 @@ namespace Components {
       // ----------------------------------------------------------------------
 
       //! Construct object AccelGyroTester
-      AccelGyroTester();
+      explicit AccelGyroTester(const Wiring& wiring = Wiring());
 
       //! Destroy object AccelGyroTester
       ~AccelGyroTester();
@@ -57,12 +82,72 @@ namespace Components {
 
       void testSetupError();
 
+      void testRegisterShadow();
+
+      void testSampleRateParams();
+
+      void testFullScaleRange();
+
+      void testBusManagerSample();
+
+      void testBusManagerFifo();
+
+      void testBusManagerOverrun();
+
       void testGetAccelTlm();
 
       void testTlmError();
 
+      void testBusBackoff();
+
+      void testDeadband();
+
+      void testRawTelemetry();
+
+      void testSampleRing();
+
+      void testSampleRingPublish();
+
       void testGetGyroTlm();
 
+      void testGetTempTlm();
+
+      void testSingleTransaction();
+
+      void testFifoDrain();
+
+      void testFifoBrownOut();
+
+      void testFifoOverflow();
+
+      void testBatchDecode();
+
+      void testDecimatorFilters();
+
+      void testDecimatedFifo();
+
+      void testDecimationConfigError();
+
+      void testRecordChunk();
+
+      void testRecordFullChunk();
+
+      void testBatchPacket();
+
+      void testSampleOut();
+
+      void testSampleClock();
+
+      void testFifoTimestamps();
+
+      void testDataReady();
+
+      void testDataReadyJob();
+
+      void testDataReadyBackoff();
+
+      void testStageLatency();
+
 
     private:
 
@@ -70,10 +155,11 @@ namespace Components {
       // Handler for typed from ports
       // ----------------------------------------------------------------------
 
-      // Handler for from_read
-      Drv::I2cStatus from_read_handler (const NATIVE_INT_TYPE portNum,    // The port number
-                                        U32 addr,                         // I2c slave device address
-                                        Fw::Buffer& serBuffer             // Buffer with data to read/write from
+      // Handler for from_writeRead
+      Drv::I2cStatus from_writeRead_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                             U32 addr,                         // I2c slave device address
+                                             Fw::Buffer& writeBuffer,          // Buffer with the register pointer
+                                             Fw::Buffer& readBuffer            // Buffer to read into
       );
 
       // Handler for from_write
@@ -82,6 +168,11 @@ namespace Components {
                                         Fw::Buffer& serBuffer             // Buffer with data to read/write from
       );
 
+      // Handler for from_recordAllocate
+      Fw::Buffer from_recordAllocate_handler (const NATIVE_INT_TYPE portNum,    // The port number
+                                              U32 size                          // The requested size
+      );
+
     private:
 
       // ----------------------------------------------------------------------
@@ -94,6 +185,18 @@ namespace Components {
       //! Initialize components
       void initComponents();
 
+      //! Check accel and gyro telemetry against the last sample burst
+      void checkSampleTlm(U32 index, F32 accelScaleFactor, F32 gyroScaleFactor);
+
+      //! Check the writes from first on disable, reset and re-enable the FIFO in the order the device honours
+      void checkFifoReset(U32 first);
+
+      //! Check a stage latency channel is consistent and counts the expected number of ticks
+      void checkLatency(const StageLatency& latency, U32 count);
+
+      //! Complete the oldest queued job the way a bus manager would
+      void completeJob(U32 index, Drv::I2cStatus status);
+
     private:
 
       // ----------------------------------------------------------------------
@@ -103,6 +206,25 @@ namespace Components {
       //! The component under test
       AccelGyro component;
 
+      // jobOut is connected
+      bool m_busManager;
+
+      // recordAllocate and recordOut are connected
+      bool m_recorder;
+
+      // batchOut is connected
+      bool m_batcher;
+
+      // sampleOut is connected
+      bool m_sampler;
+
+      // recordAllocate hands out a chunk, otherwise the buffer manager is empty
+      bool m_chunkAvailable;
+
+      // chunks handed out by recordAllocate, in turn
+      U8 m_chunkBufs[2][RawRecord::CHUNK_SIZE];
+      U32 m_chunkIndex;
+
       // read status from driver
       Drv::I2cStatus m_readStatus;
 
@@ -112,17 +234,32 @@ namespace Components {
       // buffer for storing address written
       U8 addrBuf;
 
-      // buffer for storing accel data 
-      U8 accelBuf[READ_BUF_SIZE_BYTES];
+      // FIFO_COUNT value reported by the read handler
+      U16 m_fifoCount;
+
+      // last value written to each register
+      U8 writtenRegs[NUM_REGISTERS];
+
+      // register pointer, first value and size of each write in the write history, copied as the component's write
+      // buffers do not outlive the call
+      struct WriteRecord {
+        U8 address;
+        U8 value;
+        U32 size;
+      };
+      WriteRecord m_writes[MAX_HISTORY_SIZE];
+
+      // buffer for storing the accel, temperature and gyro burst
+      U8 sampleBuf[READ_BUF_SIZE_BYTES];
 
-      // buffer for storing gyro data 
-      U8 gyroBuf[READ_BUF_SIZE_BYTES];
+      // serial buffer wrapping sampleBuf
+      Fw::SerialBuffer sampleSerBuf;
 
-      // serial buffer wrapping accelBuf
-      Fw::SerialBuffer accelSerBuf;
+      // buffer for storing the last FIFO drain
+      U8 fifoBuf[FIFO_BUF_SIZE_BYTES];
 
-      // serial buffer wrapping gyroBuf
-      Fw::SerialBuffer gyroSerBuf;
+      // serial buffer wrapping fifoBuf
+      Fw::SerialBuffer fifoSerBuf;
 
   };
 
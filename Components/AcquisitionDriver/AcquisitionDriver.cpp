@@ -0,0 +1,76 @@
+// ======================================================================
+// \title  AcquisitionDriver.cpp
+// \author aidandb
+// \brief  cpp file for AcquisitionDriver component implementation class
+// ======================================================================
+
+#include "Components/AcquisitionDriver/AcquisitionDriver.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  AcquisitionDriver ::
+    AcquisitionDriver(const char* const compName) :
+      AcquisitionDriverComponentBase(compName)
+  {
+
+  }
+
+  void AcquisitionDriver ::
+    init(const NATIVE_INT_TYPE instance)
+  {
+    AcquisitionDriverComponentBase::init(instance);
+  }
+
+  AcquisitionDriver ::
+    ~AcquisitionDriver()
+  {
+
+  }
+
+  void AcquisitionDriver ::
+    ticksMissed(U64 count)
+  {
+    this->m_missedTicks.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  U64 AcquisitionDriver ::
+    missedTicks() const
+  {
+    return this->m_missedTicks.load(std::memory_order_relaxed);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  void AcquisitionDriver ::
+    Run_handler(
+        FwIndexType portNum,
+        U32 context
+    )
+  {
+    // every bus measures its cycle from the same tick
+    Svc::TimerVal cycleStart;
+    cycleStart.take();
+
+    // the bus rate groups are active, so each call only queues the cycle and the buses are read concurrently
+    for (FwIndexType bus = 0; bus < this->getNum_CycleOut_OutputPorts(); bus++) {
+      if (this->isConnected_CycleOut_OutputPort(bus)) {
+        this->CycleOut_out(bus, cycleStart);
+      }
+    }
+
+    // a skipped tick never reaches the rate groups, so it is not a cycle slip and only shows up here; it is sent once
+    // the buses are cycled so the report never delays a read
+    const U64 missed = this->m_missedTicks.load(std::memory_order_relaxed);
+    if (missed != this->m_missedSent) {
+      this->m_missedSent = missed;
+      this->tlmWrite_cycleMissedTicks(missed);
+    }
+  }
+
+}
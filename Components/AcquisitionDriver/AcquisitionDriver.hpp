@@ -0,0 +1,69 @@
+// ======================================================================
+// \title  AcquisitionDriver.hpp
+// \author aidandb
+// \brief  hpp file for AcquisitionDriver component implementation class
+// ======================================================================
+
+#ifndef Components_AcquisitionDriver_HPP
+#define Components_AcquisitionDriver_HPP
+
+#include "Components/AcquisitionDriver/AcquisitionDriverComponentAc.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+  class AcquisitionDriver :
+    public AcquisitionDriverComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct AcquisitionDriver object
+      AcquisitionDriver(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object AcquisitionDriver
+      void init(const NATIVE_INT_TYPE instance = 0);
+
+      //! Destroy AcquisitionDriver object
+      ~AcquisitionDriver();
+
+      //! Count ticks the cycle skipped, called from the cycle's thread and sent down by the next Run
+      void ticksMissed(U64 count);
+
+      //! Ticks the cycle has skipped since startup
+      U64 missedTicks() const;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for Run
+      //!
+      //! Port receiving the acquisition tick
+      void Run_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context //!< The call order
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+
+      // added to by the cycle, read by Run and at exit
+      std::atomic<U64> m_missedTicks{0};
+      // last count sent, so a tick with nothing new costs one load
+      U64 m_missedSent = 0;
+  };
+
+}
+
+#endif
@@ -0,0 +1,22 @@
+// ======================================================================
+// \title  AcquisitionDriverTestMain.cpp
+// \author aidandb
+// \brief  cpp file for AcquisitionDriver component test main function
+// ======================================================================
+
+#include "AcquisitionDriverTester.hpp"
+
+TEST(Nominal, cycleAllBuses) {
+  Components::AcquisitionDriverTester tester;
+  tester.testCycleAllBuses();
+}
+
+TEST(Nominal, missedTicks) {
+  Components::AcquisitionDriverTester tester;
+  tester.testMissedTicks();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,78 @@
+// ======================================================================
+// \title  AcquisitionDriverTester.cpp
+// \author aidandb
+// \brief  cpp file for AcquisitionDriver component test harness implementation class
+// ======================================================================
+
+#include "AcquisitionDriverTester.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  AcquisitionDriverTester ::
+    AcquisitionDriverTester() :
+      AcquisitionDriverGTestBase("AcquisitionDriverTester", AcquisitionDriverTester::MAX_HISTORY_SIZE),
+      component("AcquisitionDriver")
+  {
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  AcquisitionDriverTester ::
+    ~AcquisitionDriverTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void AcquisitionDriverTester ::
+    testCycleAllBuses()
+  {
+    const FwIndexType buses = this->component.getNum_CycleOut_OutputPorts();
+
+    // one tick cycles every bus once, all from the same start time
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_CycleOut_SIZE(buses);
+    for (FwIndexType bus = 1; bus < buses; bus++) {
+      Svc::TimerVal first = this->fromPortHistory_CycleOut->at(0).cycleStart;
+      ASSERT_EQ(first.diffUSec(this->fromPortHistory_CycleOut->at(bus).cycleStart), 0);
+    }
+
+    this->invoke_to_Run(0, 0);
+    ASSERT_from_CycleOut_SIZE(2 * buses);
+  }
+
+
+  void AcquisitionDriverTester ::
+    testMissedTicks()
+  {
+    // nothing goes down until the cycle skips a tick, each tick cycles every bus so the port history is cleared
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_cycleMissedTicks_SIZE(0);
+
+    // the next tick sends the total, and only once
+    this->component.ticksMissed(3);
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_cycleMissedTicks_SIZE(1);
+    ASSERT_TLM_cycleMissedTicks(0, 3);
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_cycleMissedTicks_SIZE(1);
+
+    this->component.ticksMissed(2);
+    ASSERT_EQ(this->component.missedTicks(), 5);
+    this->clearFromPortHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_cycleMissedTicks_SIZE(2);
+    ASSERT_TLM_cycleMissedTicks(1, 5);
+  }
+
+}
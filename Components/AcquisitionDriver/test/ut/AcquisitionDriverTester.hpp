@@ -0,0 +1,78 @@
+// ======================================================================
+// \title  AcquisitionDriverTester.hpp
+// \author aidandb
+// \brief  hpp file for AcquisitionDriver component test harness implementation class
+// ======================================================================
+
+#ifndef Components_AcquisitionDriverTester_HPP
+#define Components_AcquisitionDriverTester_HPP
+
+#include "Components/AcquisitionDriver/AcquisitionDriverGTestBase.hpp"
+#include "Components/AcquisitionDriver/AcquisitionDriver.hpp"
+
+namespace Components {
+
+  class AcquisitionDriverTester :
+    public AcquisitionDriverGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object AcquisitionDriverTester
+      AcquisitionDriverTester();
+
+      //! Destroy object AcquisitionDriverTester
+      ~AcquisitionDriverTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testCycleAllBuses();
+
+      void testMissedTicks();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      AcquisitionDriver component;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,193 @@
+// ======================================================================
+// \title  AttitudeEstimator.cpp
+// \author aidandb
+// \brief  cpp file for AttitudeEstimator component implementation class
+// ======================================================================
+
+#include "Components/AttitudeEstimator/AttitudeEstimator.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  AttitudeEstimator ::
+    AttitudeEstimator(const char* const compName) :
+      AttitudeEstimatorComponentBase(compName)
+  {
+
+  }
+
+  void AttitudeEstimator ::
+    init(const NATIVE_INT_TYPE instance)
+  {
+    AttitudeEstimatorComponentBase::init(instance);
+  }
+
+  AttitudeEstimator ::
+    ~AttitudeEstimator()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimator ::
+    sampleIn_handler(
+        FwIndexType portNum,
+        const Components::F32x3& accel,
+        const Components::F32x3& gyro,
+        U64 timeUs
+    )
+  {
+    const F32 a[3] = {accel[0], accel[1], accel[2]};
+    const F32 w[3] = {gyro[0] * DEG_TO_RAD, gyro[1] * DEG_TO_RAD, gyro[2] * DEG_TO_RAD};
+
+    // a plain load first, the exchange only happens on the rare sample that has something to take
+    if (this->m_configPending.load(std::memory_order_relaxed) &&
+        this->m_configPending.exchange(false, std::memory_order_acquire)) {
+      configFilter();
+    }
+    if (this->m_resetPending.load(std::memory_order_relaxed) &&
+        this->m_resetPending.exchange(false, std::memory_order_acquire)) {
+      this->m_filter.reset();
+      this->m_haveTime = false;
+    }
+
+    // the first sample only seeds, a sample out of order or after a long gap moves the time without integrating
+    F32 dt = 0.0f;
+    if (this->m_haveTime) {
+      if ((timeUs > this->m_lastUs) && ((timeUs - this->m_lastUs) <= this->m_maxGapUs)) {
+        dt = static_cast<F32>(timeUs - this->m_lastUs) * 1.0e-6f;
+      }
+      else {
+        this->m_gaps++;
+        this->tlmWrite_sampleGaps(this->m_gaps);
+      }
+    }
+    this->m_haveTime = true;
+    this->m_lastUs = timeUs;
+
+    this->m_filter.update(a, w, dt);
+    this->m_samples++;
+    publish(gyro);
+
+    if (this->m_filter.seeded() && this->isConnected_attitudeOut_OutputPort(0)) {
+      const F32* const q = this->m_filter.quaternion();
+      this->attitudeOut_out(0, F32x4(q[0], q[1], q[2], q[3]), gyro, timeUs);
+    }
+  }
+
+  void AttitudeEstimator ::
+    Run_handler(
+        FwIndexType portNum,
+        U32 context
+    )
+  {
+    // samples arrive far faster than telemetry goes down, only the newest attitude is sent
+    Snapshot snapshot;
+    readSnapshot(snapshot);
+    this->tlmWrite_samplesFused(snapshot.samples);
+    if (snapshot.seeded) {
+      const F32* const q = snapshot.quaternion;
+      this->tlmWrite_attitude(F32x4(q[0], q[1], q[2], q[3]));
+      this->tlmWrite_rate(F32x3(snapshot.rate[0], snapshot.rate[1], snapshot.rate[2]));
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Parameter update hook
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimator ::
+    parameterUpdated(FwPrmIdType id)
+  {
+    switch (id) {
+      case PARAMID_ATTITUDE_FILTER:
+      case PARAMID_ATTITUDE_GAIN:
+      case PARAMID_MAX_SAMPLE_GAP_US:
+        // the sample's thread reads all of them at once, so a sample never runs with half of the new settings
+        this->m_configPending.store(true, std::memory_order_release);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void AttitudeEstimator ::
+    parametersLoaded()
+  {
+    configFilter();
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimator ::
+    RESET_ATTITUDE_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    this->m_resetPending.store(true, std::memory_order_release);
+    this->log_ACTIVITY_HI_AttitudeReset();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Functions
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimator ::
+    configFilter()
+  {
+    Fw::ParamValid valid;
+    const AttitudeFilterType filter = this->paramGet_ATTITUDE_FILTER(valid);
+    const F32 gain = this->paramGet_ATTITUDE_GAIN(valid);
+    this->m_maxGapUs = this->paramGet_MAX_SAMPLE_GAP_US(valid);
+
+    this->m_filter.configure((filter == AttitudeFilterType::MADGWICK) ? AttitudeFilter::MADGWICK
+                                                                      : AttitudeFilter::COMPLEMENTARY,
+                             gain);
+  }
+
+  void AttitudeEstimator ::
+    publish(const F32x3& rate)
+  {
+    // one writer, so the count is only ever moved here: odd while the fields are written, even once they are whole
+    const U32 seq = this->m_snapshotSeq.load(std::memory_order_relaxed);
+    this->m_snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const F32* const q = this->m_filter.quaternion();
+    for (U32 i = 0; i < 4; i++) {
+      this->m_snapshot.quaternion[i] = q[i];
+    }
+    for (U32 i = 0; i < 3; i++) {
+      this->m_snapshot.rate[i] = rate[i];
+    }
+    this->m_snapshot.samples = this->m_samples;
+    this->m_snapshot.seeded = this->m_filter.seeded();
+
+    this->m_snapshotSeq.store(seq + 2, std::memory_order_release);
+  }
+
+  void AttitudeEstimator ::
+    readSnapshot(Snapshot& snapshot) const
+  {
+    // the sample's thread runs well above Run, so a copy it interrupts is simply taken again
+    U32 before = 0;
+    U32 after = 0;
+    do {
+      before = this->m_snapshotSeq.load(std::memory_order_acquire);
+      snapshot = this->m_snapshot;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = this->m_snapshotSeq.load(std::memory_order_relaxed);
+    } while (((before & 1) != 0) || (before != after));
+  }
+
+}
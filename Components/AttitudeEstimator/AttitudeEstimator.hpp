@@ -0,0 +1,150 @@
+// ======================================================================
+// \title  AttitudeEstimator.hpp
+// \author aidandb
+// \brief  hpp file for AttitudeEstimator component implementation class
+// ======================================================================
+
+#ifndef Components_AttitudeEstimator_HPP
+#define Components_AttitudeEstimator_HPP
+
+#include "Components/AttitudeEstimator/AttitudeEstimatorComponentAc.hpp"
+#include "Components/AttitudeEstimator/AttitudeFilter.hpp"
+
+#include <atomic>
+
+namespace Components {
+
+  /**
+   * \brief quaternion attitude propagated on the thread that decodes the samples
+   *
+   * Nothing is locked. Commands and parameter changes only set a flag that the next sample takes before it is fused.
+   * Each sample publishes what Run sends under a sequence count, and Run copies it out again if a sample was
+   * publishing while it copied, so a slow rate group can never hold acquisition up.
+   */
+  class AttitudeEstimator :
+    public AttitudeEstimatorComponentBase
+  {
+
+    public:
+
+    static constexpr F32 DEG_TO_RAD = 0.017453292519943295f;
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct AttitudeEstimator object
+      AttitudeEstimator(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object AttitudeEstimator
+      void init(const NATIVE_INT_TYPE instance = 0);
+
+      //! Destroy AttitudeEstimator object
+      ~AttitudeEstimator();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for sampleIn
+      //!
+      //! Port for receiving every decoded sample
+      void sampleIn_handler(
+          FwIndexType portNum, //!< The port number
+          const Components::F32x3& accel, //!< accelerometer x/y/z
+          const Components::F32x3& gyro, //!< gyroscope x/y/z
+          U64 timeUs //!< time the sample was taken
+      ) override;
+
+      //! Handler implementation for Run
+      //!
+      //! Port for sending attitude telemetry
+      void Run_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context //!< The call order
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Parameter update hook
+      // ----------------------------------------------------------------------
+
+      //! Marks the filter settings pending for the next sample
+      void parameterUpdated(
+          FwPrmIdType id //!< The parameter ID
+      ) override;
+
+      //! Sets up the filter from the loaded parameters
+      void parametersLoaded() override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command RESET_ATTITUDE
+      //!
+      //! Command to drop the attitude and seed it again from the next sample
+      void RESET_ATTITUDE_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Helper Functions
+      // ----------------------------------------------------------------------
+
+      /**
+       * \brief Apply the filter parameters, the attitude is kept
+       */
+      void configFilter();
+
+      /**
+       * \brief Publish the attitude, rate and count for Run, on the sample's thread
+       */
+      void publish(const F32x3& rate);
+
+      //! What Run sends, written by every sample
+      struct Snapshot {
+        F32 quaternion[4];
+        F32 rate[3];
+        U32 samples;
+        bool seeded;
+      };
+
+      /**
+       * \brief Copy out the newest snapshot, again if a sample published while it was copied
+       */
+      void readSnapshot(Snapshot& snapshot) const;
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+      AttitudeFilter m_filter;
+
+      // set on the command thread, taken by the next sample
+      std::atomic<bool> m_configPending{false};
+      std::atomic<bool> m_resetPending{false};
+
+      // odd while a sample is writing m_snapshot
+      std::atomic<U32> m_snapshotSeq{0};
+      Snapshot m_snapshot = {};
+
+      // time of the newest sample, none until the first one arrives
+      bool m_haveTime = false;
+      U64 m_lastUs = 0;
+      U32 m_maxGapUs = 0;
+
+      U32 m_samples = 0;
+      U32 m_gaps = 0;
+  };
+
+}
+
+#endif
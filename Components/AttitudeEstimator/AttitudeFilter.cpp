@@ -0,0 +1,151 @@
+// ======================================================================
+// \title  AttitudeFilter.cpp
+// \author aidandb
+// \brief  cpp file for the quaternion attitude filters fed by accel and gyro samples
+// ======================================================================
+
+#include "Components/AttitudeEstimator/AttitudeFilter.hpp"
+
+#include <cmath>
+
+namespace Components {
+
+  namespace {
+    // an accelerometer reading this short carries no gravity direction, e.g. in free fall
+    const F32 MIN_ACCEL_NORM_SQUARED = 1.0e-6f;
+  }
+
+  AttitudeFilter ::
+    AttitudeFilter() :
+      m_type(COMPLEMENTARY),
+      m_gain(0.0f)
+  {
+    reset();
+  }
+
+  void AttitudeFilter ::
+    configure(Type type, F32 gain)
+  {
+    this->m_type = type;
+    this->m_gain = gain;
+  }
+
+  void AttitudeFilter ::
+    reset()
+  {
+    this->m_seeded = false;
+    this->m_q[0] = 1.0f;
+    this->m_q[1] = 0.0f;
+    this->m_q[2] = 0.0f;
+    this->m_q[3] = 0.0f;
+  }
+
+  void AttitudeFilter ::
+    update(const F32* accel, const F32* gyro, F32 dt)
+  {
+    const F32 norm2 = accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2];
+    if (!this->m_seeded) {
+      if (norm2 > MIN_ACCEL_NORM_SQUARED) {
+        seed(accel);
+      }
+      return;
+    }
+
+    const F32 q0 = this->m_q[0];
+    const F32 q1 = this->m_q[1];
+    const F32 q2 = this->m_q[2];
+    const F32 q3 = this->m_q[3];
+    F32 gx = gyro[0];
+    F32 gy = gyro[1];
+    F32 gz = gyro[2];
+    F32 step[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    // without a gravity direction the gyro is integrated alone
+    if (norm2 > MIN_ACCEL_NORM_SQUARED) {
+      const F32 recipNorm = 1.0f / std::sqrt(norm2);
+      const F32 ax = accel[0] * recipNorm;
+      const F32 ay = accel[1] * recipNorm;
+      const F32 az = accel[2] * recipNorm;
+
+      if (this->m_type == COMPLEMENTARY) {
+        // gravity as the current attitude predicts it, the cross product with the measurement is the tilt error
+        const F32 vx = 2.0f * (q1 * q3 - q0 * q2);
+        const F32 vy = 2.0f * (q0 * q1 + q2 * q3);
+        const F32 vz = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+        gx += this->m_gain * (ay * vz - az * vy);
+        gy += this->m_gain * (az * vx - ax * vz);
+        gz += this->m_gain * (ax * vy - ay * vx);
+      }
+      else {
+        // gradient descent step on the gravity error, Madgwick 2010 IMU form
+        const F32 _2q0 = 2.0f * q0;
+        const F32 _2q1 = 2.0f * q1;
+        const F32 _2q2 = 2.0f * q2;
+        const F32 _2q3 = 2.0f * q3;
+        const F32 _4q0 = 4.0f * q0;
+        const F32 _4q1 = 4.0f * q1;
+        const F32 _4q2 = 4.0f * q2;
+        const F32 _8q1 = 8.0f * q1;
+        const F32 _8q2 = 8.0f * q2;
+        const F32 q0q0 = q0 * q0;
+        const F32 q1q1 = q1 * q1;
+        const F32 q2q2 = q2 * q2;
+        const F32 q3q3 = q3 * q3;
+
+        step[0] = _4q0 * q2q2 + _2q2 * ax + _4q0 * q1q1 - _2q1 * ay;
+        step[1] = _4q1 * q3q3 - _2q3 * ax + 4.0f * q0q0 * q1 - _2q0 * ay - _4q1 + _8q1 * q1q1 + _8q1 * q2q2 + _4q1 * az;
+        step[2] = 4.0f * q0q0 * q2 + _2q0 * ax + _4q2 * q3q3 - _2q3 * ay - _4q2 + _8q2 * q1q1 + _8q2 * q2q2 + _4q2 * az;
+        step[3] = 4.0f * q1q1 * q3 - _2q1 * ax + 4.0f * q2q2 * q3 - _2q2 * ay;
+
+        // at the minimum the gradient is zero and there is nothing to normalize
+        const F32 stepNorm2 = step[0] * step[0] + step[1] * step[1] + step[2] * step[2] + step[3] * step[3];
+        if (stepNorm2 > 0.0f) {
+          const F32 scale = -this->m_gain / std::sqrt(stepNorm2);
+          for (U32 i = 0; i < 4; i++) {
+            step[i] *= scale;
+          }
+        }
+      }
+    }
+
+    integrate(gx, gy, gz, step, dt);
+  }
+
+  void AttitudeFilter ::
+    seed(const F32* accel)
+  {
+    const F32 roll = std::atan2(accel[1], accel[2]);
+    const F32 pitch = std::atan2(-accel[0], std::sqrt(accel[1] * accel[1] + accel[2] * accel[2]));
+    const F32 cr = std::cos(0.5f * roll);
+    const F32 sr = std::sin(0.5f * roll);
+    const F32 cp = std::cos(0.5f * pitch);
+    const F32 sp = std::sin(0.5f * pitch);
+
+    this->m_q[0] = cr * cp;
+    this->m_q[1] = sr * cp;
+    this->m_q[2] = cr * sp;
+    this->m_q[3] = -sr * sp;
+    this->m_seeded = true;
+  }
+
+  void AttitudeFilter ::
+    integrate(F32 gx, F32 gy, F32 gz, const F32* extra, F32 dt)
+  {
+    F32* const q = this->m_q;
+    const F32 dq0 = 0.5f * (-q[1] * gx - q[2] * gy - q[3] * gz) + extra[0];
+    const F32 dq1 = 0.5f * (q[0] * gx + q[2] * gz - q[3] * gy) + extra[1];
+    const F32 dq2 = 0.5f * (q[0] * gy - q[1] * gz + q[3] * gx) + extra[2];
+    const F32 dq3 = 0.5f * (q[0] * gz + q[1] * gy - q[2] * gx) + extra[3];
+
+    q[0] += dq0 * dt;
+    q[1] += dq1 * dt;
+    q[2] += dq2 * dt;
+    q[3] += dq3 * dt;
+
+    const F32 recipNorm = 1.0f / std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (U32 i = 0; i < 4; i++) {
+      q[i] *= recipNorm;
+    }
+  }
+
+}
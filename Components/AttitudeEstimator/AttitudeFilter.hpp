@@ -0,0 +1,86 @@
+// ======================================================================
+// \title  AttitudeFilter.hpp
+// \author aidandb
+// \brief  hpp file for the quaternion attitude filters fed by accel and gyro samples
+// ======================================================================
+
+#ifndef Components_AttitudeFilter_HPP
+#define Components_AttitudeFilter_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief propagates a unit quaternion from gyro rates and pulls it toward the gravity seen by the accelerometer
+   *
+   * Both filters do the same fixed amount of arithmetic on every sample with no branches on the data beyond the free
+   * fall check, so the cost per sample does not depend on the motion. The quaternion rotates body vectors into the
+   * level frame and is stored w, x, y, z. Yaw is not observable from gravity and drifts with the gyro bias.
+   */
+  class AttitudeFilter {
+
+    public:
+
+      enum Type {
+        COMPLEMENTARY,  //!< gyro rate plus gain times the accel/gravity cross product (Mahony, proportional only)
+        MADGWICK        //!< gyro rate minus gain times the normalized gradient of the gravity error
+      };
+
+      AttitudeFilter();
+
+      /**
+       * \brief select the filter, the attitude is kept
+       * \param type: filter to run
+       * \param gain: proportional gain for COMPLEMENTARY, beta for MADGWICK, in rad/s
+       */
+      void configure(Type type, F32 gain);
+
+      /**
+       * \brief forget the attitude, the next sample seeds it from the accelerometer
+       */
+      void reset();
+
+      /**
+       * \brief fuse one sample
+       * \param accel: accelerometer x/y/z in any unit, only the direction is used
+       * \param gyro: gyroscope x/y/z in rad/s
+       * \param dt: seconds since the previous sample, 0 only applies the seed
+       */
+      void update(const F32* accel, const F32* gyro, F32 dt);
+
+      /**
+       * \brief attitude as w, x, y, z
+       */
+      const F32* quaternion() const
+      {
+        return this->m_q;
+      }
+
+      bool seeded() const
+      {
+        return this->m_seeded;
+      }
+
+      Type type() const
+      {
+        return this->m_type;
+      }
+
+    private:
+
+      //! level attitude with the measured roll and pitch and zero yaw
+      void seed(const F32* accel);
+
+      //! quaternion rate from the corrected gyro rate, plus an extra term from MADGWICK
+      void integrate(F32 gx, F32 gy, F32 gz, const F32* extra, F32 dt);
+
+      Type m_type;
+      F32 m_gain;
+      bool m_seeded;
+      F32 m_q[4];
+  };
+
+}
+
+#endif
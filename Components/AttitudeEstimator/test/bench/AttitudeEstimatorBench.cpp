@@ -0,0 +1,244 @@
+// ======================================================================
+// \title  AttitudeEstimatorBench.cpp
+// \author aidandb
+// \brief  cpp file for AttitudeEstimator per-sample cost benchmark harness
+// ======================================================================
+
+#include "AttitudeEstimatorBench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <new>
+
+// ----------------------------------------------------------------------
+// Allocation counting
+// ----------------------------------------------------------------------
+
+namespace {
+  std::atomic<U64> g_allocations(0);
+
+  // keeps the optimizer from discarding the attitude
+  volatile F32 g_sink = 0.0f;
+
+  // a slow wobble so every sample takes the full correction path
+  const U32 MOTION_STEPS = 1024;
+
+  U64 nowNs()
+  {
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<U64>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+  }
+
+  void motion(U32 i, F32* accel, F32* gyro)
+  {
+    const F32 phase = static_cast<F32>(i % MOTION_STEPS) * (6.2831853f / MOTION_STEPS);
+    accel[0] = 0.1f * std::sin(phase);
+    accel[1] = 0.1f * std::cos(phase);
+    accel[2] = 0.99f;
+    gyro[0] = 5.0f * std::cos(phase);
+    gyro[1] = -5.0f * std::sin(phase);
+    gyro[2] = 1.0f;
+  }
+}
+
+void* operator new(std::size_t size)
+{
+  g_allocations++;
+  void* const memory = std::malloc(size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  return memory;
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  AttitudeEstimatorBench ::
+    AttitudeEstimatorBench() :
+      AttitudeEstimatorTesterBase("AttitudeEstimatorBench", AttitudeEstimatorBench::MAX_HISTORY_SIZE),
+      component("AttitudeEstimator")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+  }
+
+  AttitudeEstimatorBench ::
+    ~AttitudeEstimatorBench()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Benchmarks
+  // ----------------------------------------------------------------------
+
+  AttitudeEstimatorBench::Result AttitudeEstimatorBench ::
+    benchFilter(U32 samples, AttitudeFilter::Type type)
+  {
+    // inputs are made up front so only the filter is timed
+    F32 accel[MOTION_STEPS][3];
+    F32 gyro[MOTION_STEPS][3];
+    for (U32 i = 0; i < MOTION_STEPS; i++) {
+      motion(i, accel[i], gyro[i]);
+      for (U32 axis = 0; axis < 3; axis++) {
+        gyro[i][axis] *= AttitudeEstimator::DEG_TO_RAD;
+      }
+    }
+
+    AttitudeFilter filter;
+    filter.configure(type, (type == AttitudeFilter::MADGWICK) ? 0.1f : 0.5f);
+    filter.update(accel[0], gyro[0], 0.0f);
+
+    const U64 allocations = g_allocations;
+    const U64 start = nowNs();
+    for (U32 i = 0; i < samples; i++) {
+      const U32 step = i % MOTION_STEPS;
+      filter.update(accel[step], gyro[step], 0.001f);
+      g_sink = filter.quaternion()[1];
+    }
+    const U64 elapsed = nowNs() - start;
+
+    return makeResult((type == AttitudeFilter::MADGWICK) ? "filter.madgwick" : "filter.complementary", samples,
+                      elapsed, g_allocations - allocations);
+  }
+
+  AttitudeEstimatorBench::Result AttitudeEstimatorBench ::
+    benchSampleIn(U32 samples, AttitudeFilterType type)
+  {
+    this->paramSet_ATTITUDE_FILTER(type, Fw::ParamValid::VALID);
+    this->paramSend_ATTITUDE_FILTER(0, 0);
+
+    F32x3 accel[MOTION_STEPS];
+    F32x3 gyro[MOTION_STEPS];
+    for (U32 i = 0; i < MOTION_STEPS; i++) {
+      F32 a[3];
+      F32 g[3];
+      motion(i, a, g);
+      accel[i] = F32x3(a[0], a[1], a[2]);
+      gyro[i] = F32x3(g[0], g[1], g[2]);
+    }
+
+    U64 timeUs = 1000000;
+    this->invoke_to_sampleIn(0, accel[0], gyro[0], timeUs);
+    this->clearHistory();
+
+    // histories are cleared outside the timed region so each batch pays only for the samples
+    U64 elapsed = 0;
+    U64 allocations = 0;
+    for (U32 done = 0; done < samples; done += BATCH_SIZE) {
+      const U32 batch = ((samples - done) < BATCH_SIZE) ? (samples - done) : BATCH_SIZE;
+      const U64 batchAllocations = g_allocations;
+      const U64 start = nowNs();
+      for (U32 i = 0; i < batch; i++) {
+        const U32 step = (done + i) % MOTION_STEPS;
+        timeUs += 1000;
+        this->invoke_to_sampleIn(0, accel[step], gyro[step], timeUs);
+      }
+      elapsed += nowNs() - start;
+      allocations += g_allocations - batchAllocations;
+      this->clearHistory();
+    }
+
+    return makeResult((type == AttitudeFilterType::MADGWICK) ? "sampleIn.madgwick" : "sampleIn.complementary",
+                      samples, elapsed, allocations);
+  }
+
+  void AttitudeEstimatorBench ::
+    report(FILE* stream, Format format, const Result* results, U32 count)
+  {
+    if (format == CSV) {
+      (void) fprintf(stream, "name,samples,ns_per_sample,allocs_per_sample,budget_percent_1khz\n");
+      for (U32 i = 0; i < count; i++) {
+        const Result& r = results[i];
+        (void) fprintf(stream, "%s,%u,%.3f,%.3f,%.4f\n", r.name, r.samples, r.nsPerSample, r.allocsPerSample,
+                       r.budgetPercent);
+      }
+      return;
+    }
+
+    (void) fprintf(stream, "{\n  \"benchmarks\": [\n");
+    for (U32 i = 0; i < count; i++) {
+      const Result& r = results[i];
+      (void) fprintf(stream,
+                     "    {\"name\": \"%s\", \"samples\": %u, \"ns_per_sample\": %.3f, \"allocs_per_sample\": %.3f, "
+                     "\"budget_percent_1khz\": %.4f}%s\n",
+                     r.name, r.samples, r.nsPerSample, r.allocsPerSample, r.budgetPercent,
+                     (i + 1 < count) ? "," : "");
+    }
+    (void) fprintf(stream, "  ]\n}\n");
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimatorBench ::
+    connectPorts()
+  {
+    this->connect_to_sampleIn(0, this->component.get_sampleIn_InputPort(0));
+    this->connect_to_Run(0, this->component.get_Run_InputPort(0));
+    this->connect_to_cmdIn(0, this->component.get_cmdIn_InputPort(0));
+
+    this->component.set_attitudeOut_OutputPort(0, this->get_from_attitudeOut(0));
+    this->component.set_timeCaller_OutputPort(0, this->get_from_timeCaller(0));
+    this->component.set_cmdRegOut_OutputPort(0, this->get_from_cmdRegOut(0));
+    this->component.set_cmdResponseOut_OutputPort(0, this->get_from_cmdResponseOut(0));
+#if FW_ENABLE_TEXT_LOGGING == 1
+    this->component.set_logTextOut_OutputPort(0, this->get_from_logTextOut(0));
+#endif
+    this->component.set_logOut_OutputPort(0, this->get_from_logOut(0));
+    this->component.set_tlmOut_OutputPort(0, this->get_from_tlmOut(0));
+    this->component.set_prmGetOut_OutputPort(0, this->get_from_prmGetOut(0));
+    this->component.set_prmSetOut_OutputPort(0, this->get_from_prmSetOut(0));
+  }
+
+  void AttitudeEstimatorBench ::
+    initComponents()
+  {
+    this->init();
+    this->component.init(AttitudeEstimatorBench::TEST_INSTANCE_ID);
+  }
+
+  AttitudeEstimatorBench::Result AttitudeEstimatorBench ::
+    makeResult(const char* name, U32 samples, U64 elapsedNs, U64 allocations)
+  {
+    Result result = {name, samples, 0, 0, 0};
+    result.nsPerSample = static_cast<F64>(elapsedNs) / samples;
+    result.allocsPerSample = static_cast<F64>(allocations) / samples;
+    result.budgetPercent = 100.0 * result.nsPerSample / SAMPLE_BUDGET_NS;
+    return result;
+  }
+
+}
@@ -0,0 +1,109 @@
+// ======================================================================
+// \title  AttitudeEstimatorBench.hpp
+// \author aidandb
+// \brief  hpp file for AttitudeEstimator per-sample cost benchmark harness
+// ======================================================================
+
+#ifndef Components_AttitudeEstimatorBench_HPP
+#define Components_AttitudeEstimatorBench_HPP
+
+#include "Components/AttitudeEstimator/AttitudeEstimatorTesterBase.hpp"
+#include "Components/AttitudeEstimator/AttitudeEstimator.hpp"
+
+#include <cstdio>
+
+namespace Components {
+
+  class AttitudeEstimatorBench :
+    public AttitudeEstimatorTesterBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Histories are cleared between timed batches so they never fill
+      static const FwSizeType MAX_HISTORY_SIZE = 1024;
+
+      // Samples timed back to back before the histories are cleared
+      static const U32 BATCH_SIZE = 256;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Time available for each sample at 1 kHz
+      static const U32 SAMPLE_BUDGET_NS = 1000000;
+
+      //! Output format of the results
+      enum Format {
+        JSON,
+        CSV
+      };
+
+      //! Result of one benchmark
+      struct Result {
+        const char* name;
+        U32 samples;
+        F64 nsPerSample;
+        F64 allocsPerSample;
+        F64 budgetPercent;    //!< share of the 1 kHz sample period spent per sample
+      };
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object AttitudeEstimatorBench
+      AttitudeEstimatorBench();
+
+      //! Destroy object AttitudeEstimatorBench
+      ~AttitudeEstimatorBench();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Benchmarks
+      // ----------------------------------------------------------------------
+
+      //! AttitudeFilter::update alone
+      Result benchFilter(U32 samples, AttitudeFilter::Type type);
+
+      //! Full sampleIn_handler including the guard and attitudeOut
+      Result benchSampleIn(U32 samples, AttitudeFilterType type);
+
+      //! Print results to a stream
+      static void report(FILE* stream, Format format, const Result* results, U32 count);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Fill in the per-sample figures
+      static Result makeResult(const char* name, U32 samples, U64 elapsedNs, U64 allocations);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      AttitudeEstimator component;
+
+  };
+
+}
+
+#endif
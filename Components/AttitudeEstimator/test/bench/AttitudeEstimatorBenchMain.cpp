@@ -0,0 +1,57 @@
+// ======================================================================
+// \title  AttitudeEstimatorBenchMain.cpp
+// \author aidandb
+// \brief  cpp file for AttitudeEstimator benchmark main function
+// ======================================================================
+
+#include "AttitudeEstimatorBench.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * \brief measure the per-sample cost of attitude estimation against the 1 kHz budget
+ *
+ * Usage: AttitudeEstimator_bench [--csv] [samples]
+ *
+ * Results go to stdout as JSON unless --csv is given. Run it on the target, the host figures say little about the
+ * BeagleBone.
+ */
+int main(int argc, char** argv) {
+  Components::AttitudeEstimatorBench::Format format = Components::AttitudeEstimatorBench::JSON;
+  U32 samples = 100000;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0) {
+      format = Components::AttitudeEstimatorBench::CSV;
+    }
+    else {
+      samples = static_cast<U32>(strtoul(argv[i], nullptr, 10));
+    }
+  }
+  if (samples == 0) {
+    (void) fprintf(stderr, "Usage: %s [--csv] [samples]\n", argv[0]);
+    return 1;
+  }
+
+  Components::AttitudeEstimatorBench::Result results[4];
+  {
+    Components::AttitudeEstimatorBench bench;
+    results[0] = bench.benchFilter(samples, Components::AttitudeFilter::COMPLEMENTARY);
+  }
+  {
+    Components::AttitudeEstimatorBench bench;
+    results[1] = bench.benchFilter(samples, Components::AttitudeFilter::MADGWICK);
+  }
+  {
+    Components::AttitudeEstimatorBench bench;
+    results[2] = bench.benchSampleIn(samples, Components::AttitudeFilterType::COMPLEMENTARY);
+  }
+  {
+    Components::AttitudeEstimatorBench bench;
+    results[3] = bench.benchSampleIn(samples, Components::AttitudeFilterType::MADGWICK);
+  }
+
+  Components::AttitudeEstimatorBench::report(stdout, format, results, FW_NUM_ARRAY_ELEMENTS(results));
+  return 0;
+}
@@ -0,0 +1,57 @@
+// ======================================================================
+// \title  AttitudeEstimatorTestMain.cpp
+// \author aidandb
+// \brief  cpp file for AttitudeEstimator component test main function
+// ======================================================================
+
+#include "AttitudeEstimatorTester.hpp"
+
+TEST(Nominal, seed) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testSeed();
+}
+
+TEST(Nominal, complementaryRotation) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testRotation(Components::AttitudeFilterType::COMPLEMENTARY, 0.5f);
+}
+
+TEST(Nominal, madgwickRotation) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testRotation(Components::AttitudeFilterType::MADGWICK, 0.1f);
+}
+
+TEST(Nominal, complementaryTilt) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testTiltConvergence(Components::AttitudeFilterType::COMPLEMENTARY, 0.5f);
+}
+
+TEST(Nominal, madgwickTilt) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testTiltConvergence(Components::AttitudeFilterType::MADGWICK, 0.1f);
+}
+
+TEST(Nominal, telemetry) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testTelemetry();
+}
+
+TEST(Nominal, reset) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testReset();
+}
+
+TEST(Nominal, snapshot) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testSnapshot();
+}
+
+TEST(Error, gaps) {
+  Components::AttitudeEstimatorTester tester;
+  tester.testGaps();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,245 @@
+// ======================================================================
+// \title  AttitudeEstimatorTester.cpp
+// \author aidandb
+// \brief  cpp file for AttitudeEstimator component test harness implementation class
+// ======================================================================
+
+#include "AttitudeEstimatorTester.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace {
+  const F32 PI = 3.14159265f;
+
+  // roll and pitch in degrees of a quaternion with no yaw
+  F32 rollDeg(const Components::F32x4& q)
+  {
+    return std::atan2(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * 180.0f / PI;
+  }
+
+  F32 pitchDeg(const Components::F32x4& q)
+  {
+    return std::asin(2.0f * (q[0] * q[2] - q[3] * q[1])) * 180.0f / PI;
+  }
+}
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  AttitudeEstimatorTester ::
+    AttitudeEstimatorTester() :
+      AttitudeEstimatorGTestBase("AttitudeEstimatorTester", AttitudeEstimatorTester::MAX_HISTORY_SIZE),
+      component("AttitudeEstimator"),
+      m_timeUs(1000000)
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.loadParameters();
+  }
+
+  AttitudeEstimatorTester ::
+    ~AttitudeEstimatorTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimatorTester ::
+    testSeed()
+  {
+    // the first sample sets roll and pitch from gravity directly
+    const F32 roll = 20.0f * PI / 180.0f;
+    const F32 pitch = -35.0f * PI / 180.0f;
+    const F32x3 accel(-std::sin(pitch), std::sin(roll) * std::cos(pitch), std::cos(roll) * std::cos(pitch));
+    this->sendSample(accel, F32x3(0.0f, 0.0f, 0.0f));
+
+    const F32x4 q = this->lastAttitude();
+    ASSERT_NEAR(rollDeg(q), 20.0f, 0.01f);
+    ASSERT_NEAR(pitchDeg(q), -35.0f, 0.01f);
+    ASSERT_EQ(this->fromPortHistory_attitudeOut->at(0).timeUs, this->m_timeUs - SAMPLE_PERIOD_US);
+  }
+
+
+  void AttitudeEstimatorTester ::
+    testRotation(AttitudeFilterType filter, F32 gain)
+  {
+    this->setFilter(filter, gain);
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 0.0f));
+
+    // a quarter turn about x at 90 deg/s, one sample per millisecond, the accelerometer agreeing throughout
+    for (U32 i = 1; i <= 1000; i++) {
+      const F32 angle = static_cast<F32>(i) * 0.5f * PI / 1000.0f;
+      this->clearFromPortHistory();
+      this->sendSample(F32x3(0.0f, std::sin(angle), std::cos(angle)), F32x3(90.0f, 0.0f, 0.0f));
+    }
+
+    const F32x4 q = this->lastAttitude();
+    ASSERT_NEAR(rollDeg(q), 90.0f, 0.5f);
+    ASSERT_NEAR(pitchDeg(q), 0.0f, 0.5f);
+    ASSERT_EQ(this->fromPortHistory_attitudeOut->at(0).rate, F32x3(90.0f, 0.0f, 0.0f));
+  }
+
+
+  void AttitudeEstimatorTester ::
+    testTiltConvergence(AttitudeFilterType filter, F32 gain)
+  {
+    this->setFilter(filter, gain);
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 0.0f));
+
+    // held still at 30 degrees of pitch the accelerometer pulls a level seed over to it
+    const F32 pitch = 30.0f * PI / 180.0f;
+    for (U32 i = 0; i < 20000; i++) {
+      this->clearFromPortHistory();
+      this->sendSample(F32x3(-std::sin(pitch), 0.0f, std::cos(pitch)), F32x3(0.0f, 0.0f, 0.0f));
+    }
+
+    const F32x4 q = this->lastAttitude();
+    ASSERT_NEAR(pitchDeg(q), 30.0f, 0.5f);
+    ASSERT_NEAR(rollDeg(q), 0.0f, 0.5f);
+  }
+
+
+  void AttitudeEstimatorTester ::
+    testGaps()
+  {
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 0.0f));
+    const F32x4 seeded = this->lastAttitude();
+
+    // a sample after a long gap moves the time but is not integrated
+    this->m_timeUs += 200000;
+    this->clearHistory();
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 90.0f));
+    ASSERT_TLM_sampleGaps(0, 1);
+    F32x4 q = this->lastAttitude();
+    for (U32 i = 0; i < 4; i++) {
+      ASSERT_FLOAT_EQ(q[i], seeded[i]);
+    }
+
+    // and so is one dated before the last
+    this->m_timeUs -= 5 * SAMPLE_PERIOD_US;
+    this->clearHistory();
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 90.0f));
+    ASSERT_TLM_sampleGaps(0, 2);
+
+    // normal spacing integrates again
+    this->clearHistory();
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 90.0f));
+    ASSERT_TLM_sampleGaps_SIZE(0);
+    q = this->lastAttitude();
+    ASSERT_GT(std::fabs(q[3]), 0.0f);
+  }
+
+
+  void AttitudeEstimatorTester ::
+    testTelemetry()
+  {
+    // nothing but the count goes out before the first seed
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_samplesFused(0, 0);
+    ASSERT_TLM_attitude_SIZE(0);
+
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(1.0f, 2.0f, 3.0f));
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(4.0f, 5.0f, 6.0f));
+    this->clearHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_samplesFused(0, 2);
+    ASSERT_TLM_attitude_SIZE(1);
+    ASSERT_TLM_rate(0, F32x3(4.0f, 5.0f, 6.0f));
+  }
+
+
+  void AttitudeEstimatorTester ::
+    testReset()
+  {
+    this->sendSample(F32x3(0.0f, 1.0f, 0.0f), F32x3(0.0f, 0.0f, 0.0f));
+    ASSERT_NEAR(rollDeg(this->lastAttitude()), 90.0f, 0.01f);
+
+    this->sendCmd_RESET_ATTITUDE(0, 0);
+    ASSERT_CMD_RESPONSE(0, AttitudeEstimator::OPCODE_RESET_ATTITUDE, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_AttitudeReset_SIZE(1);
+
+    // the next sample seeds again with no gap counted
+    this->clearHistory();
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 0.0f));
+    ASSERT_NEAR(rollDeg(this->lastAttitude()), 0.0f, 0.01f);
+    ASSERT_TLM_sampleGaps_SIZE(0);
+  }
+
+  void AttitudeEstimatorTester ::
+    testSnapshot()
+  {
+    const U32 samples = 1000;
+    const F32 stepDeg = 90.0f * static_cast<F32>(SAMPLE_PERIOD_US) * 1.0e-6f;
+    this->sendSample(F32x3(0.0f, 0.0f, 1.0f), F32x3(0.0f, 0.0f, 0.0f));
+
+    // samples roll the body at 90 deg/s on their own thread while the rate group sends telemetry, every attitude sent
+    // must be the one fused with the count sent beside it
+    std::atomic<bool> done(false);
+    std::thread imu([this, &done, samples, stepDeg]() {
+      for (U32 i = 1; i <= samples; i++) {
+        const F32 angle = static_cast<F32>(i) * stepDeg * PI / 180.0f;
+        this->clearFromPortHistory();
+        this->sendSample(F32x3(0.0f, std::sin(angle), std::cos(angle)), F32x3(90.0f, 0.0f, 0.0f));
+      }
+      done.store(true);
+    });
+
+    // the count only goes out when it has changed, the attitude every time
+    U32 checked = 0;
+    do {
+      this->clearHistory();
+      this->invoke_to_Run(0, 0);
+      EXPECT_EQ(this->tlmHistory_attitude->size(), 1);
+      if ((this->tlmHistory_samplesFused->size() == 1) && (this->tlmHistory_attitude->size() == 1)) {
+        const U32 fused = this->tlmHistory_samplesFused->at(0).arg;
+        EXPECT_NEAR(rollDeg(this->tlmHistory_attitude->at(0).arg), static_cast<F32>(fused - 1) * stepDeg, 0.5f);
+        checked++;
+      }
+    } while (!done.load());
+    imu.join();
+    ASSERT_GT(checked, 0);
+
+    this->clearHistory();
+    this->invoke_to_Run(0, 0);
+    ASSERT_TLM_attitude_SIZE(1);
+    ASSERT_NEAR(rollDeg(this->tlmHistory_attitude->at(0).arg), 90.0f, 0.5f);
+    ASSERT_TLM_rate(0, F32x3(90.0f, 0.0f, 0.0f));
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void AttitudeEstimatorTester ::
+    setFilter(AttitudeFilterType filter, F32 gain)
+  {
+    this->paramSet_ATTITUDE_FILTER(filter, Fw::ParamValid::VALID);
+    this->paramSend_ATTITUDE_FILTER(0, 0);
+    this->paramSet_ATTITUDE_GAIN(gain, Fw::ParamValid::VALID);
+    this->paramSend_ATTITUDE_GAIN(0, 0);
+    this->clearHistory();
+  }
+
+  void AttitudeEstimatorTester ::
+    sendSample(const F32x3& accel, const F32x3& gyro)
+  {
+    this->invoke_to_sampleIn(0, accel, gyro, this->m_timeUs);
+    this->m_timeUs += SAMPLE_PERIOD_US;
+  }
+
+  F32x4 AttitudeEstimatorTester ::
+    lastAttitude()
+  {
+    EXPECT_GT(this->fromPortHistory_attitudeOut->size(), 0);
+    return this->fromPortHistory_attitudeOut->at(this->fromPortHistory_attitudeOut->size() - 1).quaternion;
+  }
+
+}
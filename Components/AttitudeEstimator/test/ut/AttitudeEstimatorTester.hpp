@@ -0,0 +1,103 @@
+// ======================================================================
+// \title  AttitudeEstimatorTester.hpp
+// \author aidandb
+// \brief  hpp file for AttitudeEstimator component test harness implementation class
+// ======================================================================
+
+#ifndef Components_AttitudeEstimatorTester_HPP
+#define Components_AttitudeEstimatorTester_HPP
+
+#include "Components/AttitudeEstimator/AttitudeEstimatorGTestBase.hpp"
+#include "Components/AttitudeEstimator/AttitudeEstimator.hpp"
+
+namespace Components {
+
+  class AttitudeEstimatorTester :
+    public AttitudeEstimatorGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Time between samples, the 1 kHz FIFO rate
+      static const U32 SAMPLE_PERIOD_US = 1000;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object AttitudeEstimatorTester
+      AttitudeEstimatorTester();
+
+      //! Destroy object AttitudeEstimatorTester
+      ~AttitudeEstimatorTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testSeed();
+
+      void testRotation(AttitudeFilterType filter, F32 gain);
+
+      void testTiltConvergence(AttitudeFilterType filter, F32 gain);
+
+      void testGaps();
+
+      void testTelemetry();
+
+      void testReset();
+
+      void testSnapshot();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Select the filter through its parameters
+      void setFilter(AttitudeFilterType filter, F32 gain);
+
+      //! Send one sample one period after the last
+      void sendSample(const F32x3& accel, const F32x3& gyro);
+
+      //! Quaternion of the newest attitudeOut call
+      F32x4 lastAttitude();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      AttitudeEstimator component;
+
+      // time of the next sample
+      U64 m_timeUs;
+
+  };
+
+}
+
+#endif
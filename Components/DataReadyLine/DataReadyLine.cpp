@@ -0,0 +1,99 @@
+// ======================================================================
+// \title  DataReadyLine.cpp
+// \author aidandb
+// \brief  cpp file for DataReadyLine component implementation class
+// ======================================================================
+
+#include "Components/DataReadyLine/DataReadyLine.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  DataReadyLine ::
+    DataReadyLine(const char* const compName) :
+      DataReadyLineComponentBase(compName)
+  {
+
+  }
+
+  void DataReadyLine ::
+    init(const NATIVE_INT_TYPE instance)
+  {
+    DataReadyLineComponentBase::init(instance);
+  }
+
+  DataReadyLine ::
+    ~DataReadyLine()
+  {
+
+  }
+
+  void DataReadyLine ::
+    setup(EdgeSource& source)
+  {
+    this->m_source = &source;
+  }
+
+  Os::Task::Status DataReadyLine ::
+    start(const Fw::StringBase& name, Os::Task::ParamType priority, Os::Task::ParamType stackSize,
+          Os::Task::ParamType cpuAffinity)
+  {
+    FW_ASSERT(this->m_source != nullptr);
+    this->m_running.store(true, std::memory_order_relaxed);
+    Os::Task::Arguments arguments(name, DataReadyLine::waitTask, this, priority, stackSize, cpuAffinity);
+    return this->m_task.start(arguments);
+  }
+
+  void DataReadyLine ::
+    stop()
+  {
+    this->m_running.store(false, std::memory_order_relaxed);
+  }
+
+  Os::Task::Status DataReadyLine ::
+    join()
+  {
+    return this->m_task.join();
+  }
+
+  bool DataReadyLine ::
+    waitEdge(U32 timeoutMs)
+  {
+    FW_ASSERT(this->m_source != nullptr);
+
+    EdgeSource::Edge edge;
+    switch (this->m_source->wait(timeoutMs, edge)) {
+      case EdgeSource::EDGE:
+        // the IMU reads its sample before anything else is done with the edge
+        if (this->isConnected_dataReadyOut_OutputPort(0)) {
+          this->dataReadyOut_out(0, edge.timeUs);
+        }
+        if (edge.missed > 0) {
+          this->m_edgesMissed += edge.missed;
+          this->tlmWrite_edgesMissed(this->m_edgesMissed);
+          this->log_WARNING_LO_EdgesMissed(edge.missed, this->m_edgesMissed);
+        }
+        return true;
+      case EdgeSource::TIMEOUT:
+        return true;
+      default:
+        this->log_WARNING_HI_LineError(edge.error);
+        return false;
+    }
+  }
+
+  void DataReadyLine ::
+    waitTask(void* line)
+  {
+    FW_ASSERT(line != nullptr);
+    DataReadyLine* const self = static_cast<DataReadyLine*>(line);
+
+    // a failed line stops the thread rather than spinning on the error
+    while (self->m_running.load(std::memory_order_relaxed) && self->waitEdge(WAIT_TIMEOUT_MS)) {
+    }
+  }
+
+}
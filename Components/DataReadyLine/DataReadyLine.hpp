@@ -0,0 +1,88 @@
+// ======================================================================
+// \title  DataReadyLine.hpp
+// \author aidandb
+// \brief  hpp file for DataReadyLine component implementation class
+// ======================================================================
+
+#ifndef Components_DataReadyLine_HPP
+#define Components_DataReadyLine_HPP
+
+#include <atomic>
+
+#include "Components/DataReadyLine/DataReadyLineComponentAc.hpp"
+#include "Components/DataReadyLine/EdgeSource.hpp"
+#include "Os/Task.hpp"
+
+namespace Components {
+
+  class DataReadyLine :
+    public DataReadyLineComponentBase
+  {
+
+    public:
+
+      // longest wait on the line, bounds how long the thread takes to notice stop()
+      static const U32 WAIT_TIMEOUT_MS = 100;
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct DataReadyLine object
+      DataReadyLine(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object DataReadyLine
+      void init(const NATIVE_INT_TYPE instance = 0);
+
+      //! Destroy DataReadyLine object
+      ~DataReadyLine();
+
+      /**
+       * \brief set what edges are waited on, before start()
+       * \param source: a GpioLineEdgeSource or a stand-in, must outlive the component
+       */
+      void setup(EdgeSource& source);
+
+      /**
+       * \brief start the thread that waits on the line, dataReadyOut is called on it
+       */
+      Os::Task::Status start(const Fw::StringBase& name, Os::Task::ParamType priority, Os::Task::ParamType stackSize,
+                             Os::Task::ParamType cpuAffinity = Os::Task::TASK_DEFAULT);
+
+      /**
+       * \brief ask the thread to stop, it does within WAIT_TIMEOUT_MS
+       */
+      void stop();
+
+      /**
+       * \brief wait for the thread to stop
+       */
+      Os::Task::Status join();
+
+      /**
+       * \brief wait for one edge and pass it on, the body of the thread
+       * \return false once the line has failed
+       */
+      bool waitEdge(U32 timeoutMs);
+
+    PRIVATE:
+
+      //! Thread entry, waits on the line until stopped or the line fails
+      static void waitTask(void* line);
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+
+      EdgeSource* m_source = nullptr;
+      Os::Task m_task;
+      std::atomic<bool> m_running{false};
+
+      U32 m_edgesMissed = 0;
+  };
+
+}
+
+#endif
@@ -0,0 +1,49 @@
+// ======================================================================
+// \title  EdgeSource.hpp
+// \author aidandb
+// \brief  hpp file for the interface DataReadyLine waits on for edges
+// ======================================================================
+
+#ifndef Components_EdgeSource_HPP
+#define Components_EdgeSource_HPP
+
+#include <Fw/Types/BasicTypes.hpp>
+
+namespace Components {
+
+  /**
+   * \brief something that blocks until the next edge on a line and knows when it happened
+   *
+   * GpioLineEdgeSource waits on a Linux GPIO line. Anything else that can produce dated edges, such as a test double
+   * or a simulated device, can stand in for it.
+   */
+  class EdgeSource {
+
+    public:
+
+      enum Status {
+        EDGE,     //!< an edge was read
+        TIMEOUT,  //!< no edge before the timeout
+        FAILED    //!< the line can no longer be waited on
+      };
+
+      //! One edge, or why there was none
+      struct Edge {
+        U64 timeUs = 0;   //!< time of the edge, on the clock samples are dated with
+        U32 missed = 0;   //!< edges lost between the last one read and this one
+        I32 error = 0;    //!< errno when the wait failed
+      };
+
+      virtual ~EdgeSource() {}
+
+      /**
+       * \brief block until the next edge
+       * \param timeoutMs: longest time to wait
+       * \param edge: filled with the edge, or the error when the wait failed
+       */
+      virtual Status wait(U32 timeoutMs, Edge& edge) = 0;
+  };
+
+}
+
+#endif
@@ -0,0 +1,110 @@
+// ======================================================================
+// \title  GpioLineEdgeSource.cpp
+// \author aidandb
+// \brief  cpp file for rising edges read from a Linux GPIO character device line
+// ======================================================================
+
+#include "Components/DataReadyLine/GpioLineEdgeSource.hpp"
+
+#include <Fw/Types/Assert.hpp>
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace Components {
+
+  GpioLineEdgeSource ::
+    GpioLineEdgeSource() :
+      m_fd(-1),
+      m_lastSeqno(0)
+  {
+
+  }
+
+  GpioLineEdgeSource ::
+    ~GpioLineEdgeSource()
+  {
+    close();
+  }
+
+  I32 GpioLineEdgeSource ::
+    open(const char* chipPath, U32 line, const char* consumer)
+  {
+    FW_ASSERT(chipPath != nullptr);
+    FW_ASSERT(consumer != nullptr);
+    close();
+
+    const int chipFd = ::open(chipPath, O_RDONLY | O_CLOEXEC);
+    if (chipFd < 0) {
+      return errno;
+    }
+
+    // the kernel dates each edge in its interrupt handler on the realtime clock, the same clock Fw::Time is read from,
+    // so the time does not include however long the thread took to wake
+    struct gpio_v2_line_request request;
+    memset(&request, 0, sizeof request);
+    request.offsets[0] = line;
+    request.num_lines = 1;
+    request.config.flags =
+        GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EVENT_CLOCK_REALTIME;
+    request.event_buffer_size = EVENT_BUFFER_SIZE;
+    (void) strncpy(request.consumer, consumer, sizeof request.consumer - 1);
+
+    const I32 error = (ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request) < 0) ? errno : 0;
+    (void) ::close(chipFd);
+    if (error == 0) {
+      this->m_fd = request.fd;
+      this->m_lastSeqno = 0;
+    }
+    return error;
+  }
+
+  void GpioLineEdgeSource ::
+    close()
+  {
+    if (this->m_fd >= 0) {
+      (void) ::close(this->m_fd);
+      this->m_fd = -1;
+    }
+  }
+
+  EdgeSource::Status GpioLineEdgeSource ::
+    wait(U32 timeoutMs, Edge& edge)
+  {
+    FW_ASSERT(this->m_fd >= 0);
+
+    struct pollfd pollFd;
+    pollFd.fd = this->m_fd;
+    pollFd.events = POLLIN;
+    pollFd.revents = 0;
+    const int ready = poll(&pollFd, 1, static_cast<int>(timeoutMs));
+    if ((ready == 0) || ((ready < 0) && (errno == EINTR))) {
+      return TIMEOUT;
+    }
+    if (ready < 0) {
+      edge.error = errno;
+      return FAILED;
+    }
+
+    struct gpio_v2_line_event event;
+    const ssize_t size = read(this->m_fd, &event, sizeof event);
+    if (size != static_cast<ssize_t>(sizeof event)) {
+      edge.error = (size < 0) ? errno : EIO;
+      return FAILED;
+    }
+
+    // line_seqno counts every edge seen on the line, a gap is edges dropped from a full kernel queue
+    edge.missed = (this->m_lastSeqno == 0) ? 0 : (event.line_seqno - this->m_lastSeqno - 1);
+    this->m_lastSeqno = event.line_seqno;
+    edge.timeUs = event.timestamp_ns / 1000;
+    edge.error = 0;
+    return EDGE;
+  }
+
+}
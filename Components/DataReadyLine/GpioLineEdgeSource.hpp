@@ -0,0 +1,60 @@
+// ======================================================================
+// \title  GpioLineEdgeSource.hpp
+// \author aidandb
+// \brief  hpp file for rising edges read from a Linux GPIO character device line
+// ======================================================================
+
+#ifndef Components_GpioLineEdgeSource_HPP
+#define Components_GpioLineEdgeSource_HPP
+
+#include "Components/DataReadyLine/EdgeSource.hpp"
+
+namespace Components {
+
+  /**
+   * \brief rising edges on one line of a GPIO chip, timestamped by the kernel when the interrupt fired
+   *
+   * Uses the v2 GPIO character device interface (Linux 5.11 or later for realtime timestamps). The kernel queues
+   * edges until they are read, one that finds the queue full drops the oldest and shows up as missed on the next read.
+   */
+  class GpioLineEdgeSource final :
+    public EdgeSource
+  {
+
+    public:
+
+      // edges the kernel holds for the line before it starts dropping them
+      static const U32 EVENT_BUFFER_SIZE = 16;
+
+      GpioLineEdgeSource();
+
+      ~GpioLineEdgeSource();
+
+      /**
+       * \brief request a line as an input reporting rising edges, any line already held is released first
+       * \param chipPath: GPIO chip device, e.g. /dev/gpiochip0
+       * \param line: line offset on the chip
+       * \param consumer: label the line is shown with in gpioinfo
+       * \return 0, or the errno of the call that failed
+       */
+      I32 open(const char* chipPath, U32 line, const char* consumer);
+
+      /**
+       * \brief release the line
+       */
+      void close();
+
+      Status wait(U32 timeoutMs, Edge& edge) override;
+
+    private:
+
+      // line request file descriptor, -1 when no line is held
+      int m_fd;
+
+      // line_seqno of the last edge read, 0 before the first
+      U32 m_lastSeqno;
+  };
+
+}
+
+#endif
@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  DataReadyLineTestMain.cpp
+// \author aidandb
+// \brief  cpp file for DataReadyLine component test main function
+// ======================================================================
+
+#include "DataReadyLineTester.hpp"
+
+TEST(Nominal, edgeTime) {
+  Components::DataReadyLineTester tester;
+  tester.testEdgeTime();
+}
+
+TEST(Nominal, missedEdges) {
+  Components::DataReadyLineTester tester;
+  tester.testMissedEdges();
+}
+
+TEST(Error, lineError) {
+  Components::DataReadyLineTester tester;
+  tester.testLineError();
+}
+
+TEST(Nominal, task) {
+  Components::DataReadyLineTester tester;
+  tester.testTask();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
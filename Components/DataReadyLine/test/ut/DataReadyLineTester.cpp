@@ -0,0 +1,143 @@
+// ======================================================================
+// \title  DataReadyLineTester.cpp
+// \author aidandb
+// \brief  cpp file for DataReadyLine component test harness implementation class
+// ======================================================================
+
+#include "DataReadyLineTester.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Scripted edge source
+  // ----------------------------------------------------------------------
+
+  void ScriptedEdgeSource ::
+    push(Status status, U64 timeUs, U32 missed, I32 error)
+  {
+    FW_ASSERT(this->m_count < MAX_STEPS, static_cast<FwAssertArgType>(this->m_count));
+    this->m_status[this->m_count] = status;
+    this->m_edges[this->m_count].timeUs = timeUs;
+    this->m_edges[this->m_count].missed = missed;
+    this->m_edges[this->m_count].error = error;
+    this->m_count++;
+  }
+
+  EdgeSource::Status ScriptedEdgeSource ::
+    wait(U32 timeoutMs, Edge& edge)
+  {
+    this->m_waits.fetch_add(1);
+    if (this->m_next == this->m_count) {
+      return TIMEOUT;
+    }
+    edge = this->m_edges[this->m_next];
+    return this->m_status[this->m_next++];
+  }
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  DataReadyLineTester ::
+    DataReadyLineTester() :
+      DataReadyLineGTestBase("DataReadyLineTester", DataReadyLineTester::MAX_HISTORY_SIZE),
+      component("DataReadyLine")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.setup(this->m_source);
+  }
+
+  DataReadyLineTester ::
+    ~DataReadyLineTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void DataReadyLineTester ::
+    testEdgeTime()
+  {
+    this->m_source.push(EdgeSource::EDGE, 100500000);
+    this->m_source.push(EdgeSource::EDGE, 100501000);
+
+    // each edge goes out with the time the line reported, not the time it was read
+    this->setTestTime(Fw::Time(TB_NONE, 200, 0));
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_from_dataReadyOut_SIZE(2);
+    ASSERT_from_dataReadyOut(0, 100500000);
+    ASSERT_from_dataReadyOut(1, 100501000);
+
+    // a wait that times out passes nothing on and keeps the line open
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_from_dataReadyOut_SIZE(2);
+    ASSERT_EVENTS_SIZE(0);
+    ASSERT_TLM_SIZE(0);
+  }
+
+
+  void DataReadyLineTester ::
+    testMissedEdges()
+  {
+    this->m_source.push(EdgeSource::EDGE, 1000, 3);
+    this->m_source.push(EdgeSource::EDGE, 2000, 0);
+    this->m_source.push(EdgeSource::EDGE, 3000, 2);
+
+    // the edge that follows a gap is still passed on, the gap is counted
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_from_dataReadyOut_SIZE(1);
+    ASSERT_TLM_edgesMissed_SIZE(1);
+    ASSERT_TLM_edgesMissed(0, 3);
+    ASSERT_EVENTS_EdgesMissed_SIZE(1);
+    ASSERT_EVENTS_EdgesMissed(0, 3, 3);
+
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_TLM_edgesMissed_SIZE(1);
+
+    ASSERT_TRUE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_from_dataReadyOut_SIZE(3);
+    ASSERT_TLM_edgesMissed(1, 5);
+    ASSERT_EVENTS_EdgesMissed(1, 2, 5);
+  }
+
+
+  void DataReadyLineTester ::
+    testLineError()
+  {
+    this->m_source.push(EdgeSource::FAILED, 0, 0, EIO);
+
+    // a failed line is reported once and ends the wait loop
+    ASSERT_FALSE(this->component.waitEdge(DataReadyLine::WAIT_TIMEOUT_MS));
+    ASSERT_from_dataReadyOut_SIZE(0);
+    ASSERT_EVENTS_LineError_SIZE(1);
+    ASSERT_EVENTS_LineError(0, EIO);
+  }
+
+
+  void DataReadyLineTester ::
+    testTask()
+  {
+    this->m_source.push(EdgeSource::EDGE, 1000);
+
+    // the thread keeps waiting through timeouts until it is stopped
+    Os::TaskString name("DataReadyTest");
+    ASSERT_EQ(this->component.start(name, Os::Task::TASK_DEFAULT, Os::Task::TASK_DEFAULT), Os::Task::Status::OP_OK);
+    while (this->m_source.m_waits.load() < 3) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    this->component.stop();
+    ASSERT_EQ(this->component.join(), Os::Task::Status::OP_OK);
+
+    ASSERT_from_dataReadyOut_SIZE(1);
+    ASSERT_from_dataReadyOut(0, 1000);
+  }
+
+}
@@ -0,0 +1,109 @@
+// ======================================================================
+// \title  DataReadyLineTester.hpp
+// \author aidandb
+// \brief  hpp file for DataReadyLine component test harness implementation class
+// ======================================================================
+
+#ifndef Components_DataReadyLineTester_HPP
+#define Components_DataReadyLineTester_HPP
+
+#include "Components/DataReadyLine/DataReadyLineGTestBase.hpp"
+#include "Components/DataReadyLine/DataReadyLine.hpp"
+
+namespace Components {
+
+  //! Stands in for the GPIO line, hands out scripted edges and then times out
+  class ScriptedEdgeSource final :
+    public EdgeSource
+  {
+
+    public:
+
+      static const FwSizeType MAX_STEPS = 8;
+
+      //! Queue the next result of wait()
+      void push(Status status, U64 timeUs, U32 missed = 0, I32 error = 0);
+
+      Status wait(U32 timeoutMs, Edge& edge) override;
+
+      // results queued and handed out so far
+      Status m_status[MAX_STEPS] = {};
+      Edge m_edges[MAX_STEPS];
+      FwSizeType m_count = 0;
+      FwSizeType m_next = 0;
+
+      // calls to wait(), timeouts included
+      std::atomic<U32> m_waits{0};
+  };
+
+  class DataReadyLineTester :
+    public DataReadyLineGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object DataReadyLineTester
+      DataReadyLineTester();
+
+      //! Destroy object DataReadyLineTester
+      ~DataReadyLineTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testEdgeTime();
+
+      void testMissedEdges();
+
+      void testLineError();
+
+      void testTask();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      DataReadyLine component;
+
+      //! The line the component waits on
+      ScriptedEdgeSource m_source;
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,117 @@
+// ======================================================================
+// \title  I2cBusManager.cpp
+// \author aidandb
+// \brief  cpp file for I2cBusManager component implementation class
+// ======================================================================
+
+#include "Components/I2cBusManager/I2cBusManager.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  I2cBusManager ::
+    I2cBusManager(const char* const compName) :
+      I2cBusManagerComponentBase(compName)
+  {
+
+  }
+
+  void I2cBusManager ::
+    init(const NATIVE_INT_TYPE queueDepth, const NATIVE_INT_TYPE instance)
+  {
+    I2cBusManagerComponentBase::init(queueDepth, instance);
+  }
+
+  I2cBusManager ::
+    ~I2cBusManager()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  void I2cBusManager ::
+    jobIn_handler(
+        FwIndexType portNum,
+        U32 context,
+        U32 addr,
+        const Fw::Buffer& writeBuffer,
+        const Fw::Buffer& readBuffer
+    )
+  {
+    Fw::Buffer writeData(writeBuffer);
+    Fw::Buffer readData(readBuffer);
+    Drv::I2cStatus status = Drv::I2cStatus::I2C_OK;
+
+    // a job with both halves is one transaction with a repeated start, so no other master gets the bus in between
+    this->m_busLock.lock();
+    if ((writeData.getSize() > 0) && (readData.getSize() > 0)) {
+      status = this->busWriteRead_out(0, addr, writeData, readData);
+    }
+    else if (writeData.getSize() > 0) {
+      status = this->busWrite_out(0, addr, writeData);
+    }
+    else if (readData.getSize() > 0) {
+      status = this->busRead_out(0, addr, readData);
+    }
+    this->m_busLock.unLock();
+
+    this->m_jobsCompleted++;
+    this->tlmWrite_jobsCompleted(this->m_jobsCompleted);
+    if (status != Drv::I2cStatus::I2C_OK) {
+      this->m_jobErrors++;
+      this->tlmWrite_jobErrors(this->m_jobErrors);
+    }
+
+    // completions go out with the bus released so a client can start its next transaction from the callback
+    if (this->isConnected_jobDoneOut_OutputPort(portNum)) {
+      this->jobDoneOut_out(portNum, context, status, readData);
+    }
+  }
+
+  Drv::I2cStatus I2cBusManager ::
+    write_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& serBuffer
+    )
+  {
+    this->m_busLock.lock();
+    const Drv::I2cStatus status = this->busWrite_out(0, addr, serBuffer);
+    this->m_busLock.unLock();
+    return status;
+  }
+
+  Drv::I2cStatus I2cBusManager ::
+    read_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& serBuffer
+    )
+  {
+    this->m_busLock.lock();
+    const Drv::I2cStatus status = this->busRead_out(0, addr, serBuffer);
+    this->m_busLock.unLock();
+    return status;
+  }
+
+  Drv::I2cStatus I2cBusManager ::
+    writeRead_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& writeBuffer,
+        Fw::Buffer& readBuffer
+    )
+  {
+    this->m_busLock.lock();
+    const Drv::I2cStatus status = this->busWriteRead_out(0, addr, writeBuffer, readBuffer);
+    this->m_busLock.unLock();
+    return status;
+  }
+
+}
@@ -0,0 +1,97 @@
+// ======================================================================
+// \title  I2cBusManager.hpp
+// \author aidandb
+// \brief  hpp file for I2cBusManager component implementation class
+// ======================================================================
+
+#ifndef Components_I2cBusManager_HPP
+#define Components_I2cBusManager_HPP
+
+#include "Components/I2cBusManager/I2cBusManagerComponentAc.hpp"
+#include "Os/Mutex.hpp"
+
+namespace Components {
+
+  class I2cBusManager :
+    public I2cBusManagerComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct I2cBusManager object
+      I2cBusManager(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object I2cBusManager
+      void init(
+          const NATIVE_INT_TYPE queueDepth, //!< The queue depth, at least one per connected client
+          const NATIVE_INT_TYPE instance = 0
+      );
+
+      //! Destroy I2cBusManager object
+      ~I2cBusManager();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for jobIn
+      //!
+      //! Port for queueing jobs, one per client, each client keeps at most one job in flight
+      void jobIn_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context, //!< client defined tag, returned with the completion
+          U32 addr, //!< I2C slave device address
+          const Fw::Buffer& writeBuffer, //!< data to write, must stay valid until the completion
+          const Fw::Buffer& readBuffer //!< space to read into, must stay valid until the completion
+      ) override;
+
+      //! Handler implementation for write
+      //!
+      //! Port for writing to the bus from the caller's thread, used for configuration
+      Drv::I2cStatus write_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler implementation for read
+      //!
+      //! Port for reading from the bus from the caller's thread, used for configuration
+      Drv::I2cStatus read_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler implementation for writeRead
+      //!
+      //! Port for a write then repeated start read from the caller's thread, used for configuration
+      Drv::I2cStatus writeRead_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& writeBuffer, //!< Buffer to write data to the i2c device
+          Fw::Buffer& readBuffer //!< Buffer to read back data from the i2c device, must set size when passing in read buffer
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+
+      // serializes queued jobs with configuration traffic from other threads
+      Os::Mutex m_busLock;
+
+      U32 m_jobsCompleted = 0;
+      U32 m_jobErrors = 0;
+  };
+
+}
+
+#endif
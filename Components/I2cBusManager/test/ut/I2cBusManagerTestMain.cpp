@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  I2cBusManagerTestMain.cpp
+// \author aidandb
+// \brief  cpp file for I2cBusManager component test main function
+// ======================================================================
+
+#include "I2cBusManagerTester.hpp"
+
+TEST(Nominal, writeThenRead) {
+  Components::I2cBusManagerTester tester;
+  tester.testWriteThenRead();
+}
+
+TEST(Nominal, jobOrder) {
+  Components::I2cBusManagerTester tester;
+  tester.testJobOrder();
+}
+
+TEST(Error, writeError) {
+  Components::I2cBusManagerTester tester;
+  tester.testWriteError();
+}
+
+TEST(Nominal, syncAccess) {
+  Components::I2cBusManagerTester tester;
+  tester.testSyncAccess();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
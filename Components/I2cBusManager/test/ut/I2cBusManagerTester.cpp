@@ -0,0 +1,206 @@
+// ======================================================================
+// \title  I2cBusManagerTester.cpp
+// \author aidandb
+// \brief  cpp file for I2cBusManager component test harness implementation class
+// ======================================================================
+
+#include "I2cBusManagerTester.hpp"
+
+#define ADDRESS_TEST 0x68
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  I2cBusManagerTester ::
+    I2cBusManagerTester() :
+      I2cBusManagerGTestBase("I2cBusManagerTester", I2cBusManagerTester::MAX_HISTORY_SIZE),
+      component("I2cBusManager"),
+      m_doneCount(0)
+  {
+    memset(this->m_donePorts, 0, sizeof this->m_donePorts);
+    this->initComponents();
+    this->connectPorts();
+  }
+
+  I2cBusManagerTester ::
+    ~I2cBusManagerTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void I2cBusManagerTester ::
+    testWriteThenRead()
+  {
+    U8 pointer = 0x3B;
+    U8 data[14] = {};
+    Fw::Buffer writeBuffer(&pointer, sizeof pointer);
+    Fw::Buffer readBuffer(data, sizeof data);
+
+    // nothing touches the bus until the job is dispatched on the manager thread
+    this->invoke_to_jobIn(2, 7, ADDRESS_TEST, writeBuffer, readBuffer);
+    ASSERT_from_busWriteRead_SIZE(0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+
+    // both halves go out as one repeated start transaction
+    ASSERT_from_busWrite_SIZE(0);
+    ASSERT_from_busRead_SIZE(0);
+    ASSERT_from_busWriteRead_SIZE(1);
+    ASSERT_from_busWriteRead(0, ADDRESS_TEST, writeBuffer, readBuffer);
+
+    // the completion returns on the client's port with the bytes read
+    ASSERT_from_jobDoneOut_SIZE(1);
+    ASSERT_from_jobDoneOut(0, 7, Drv::I2cStatus::I2C_OK, readBuffer);
+    ASSERT_EQ(this->m_donePorts[0], 2);
+    ASSERT_EQ(data[0], 0xA5);
+    ASSERT_EQ(data[13], 0xA5);
+    ASSERT_TLM_jobsCompleted(0, 1);
+    ASSERT_TLM_jobErrors_SIZE(0);
+  }
+
+
+  void I2cBusManagerTester ::
+    testJobOrder()
+  {
+    U8 pointers[3] = {0x3B, 0x72, 0x74};
+    U8 data[3][2] = {};
+
+    // jobs from several clients are run in the order they were queued
+    for (U32 i = 0; i < 3; i++) {
+      Fw::Buffer writeBuffer(&pointers[i], 1);
+      Fw::Buffer readBuffer(data[i], sizeof data[i]);
+      this->invoke_to_jobIn(i, i, ADDRESS_TEST + i, writeBuffer, readBuffer);
+    }
+    for (U32 i = 0; i < 3; i++) {
+      ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    }
+
+    ASSERT_from_busWriteRead_SIZE(3);
+    ASSERT_from_jobDoneOut_SIZE(3);
+    for (U32 i = 0; i < 3; i++) {
+      ASSERT_EQ(this->fromPortHistory_busWriteRead->at(i).addr, ADDRESS_TEST + i);
+      ASSERT_EQ(this->fromPortHistory_busWriteRead->at(i).writeBuffer.getData()[0], pointers[i]);
+      ASSERT_EQ(this->fromPortHistory_jobDoneOut->at(i).context, i);
+      ASSERT_EQ(this->m_donePorts[i], static_cast<FwIndexType>(i));
+    }
+  }
+
+
+  void I2cBusManagerTester ::
+    testWriteError()
+  {
+    U8 pointer = 0x3B;
+    U8 data[14] = {};
+    Fw::Buffer writeBuffer(&pointer, sizeof pointer);
+    Fw::Buffer readBuffer(data, sizeof data);
+
+    // a NACKed transaction is reported to the client
+    this->m_writeStatus = Drv::I2cStatus::I2C_ADDRESS_ERR;
+    this->invoke_to_jobIn(0, 1, ADDRESS_TEST, writeBuffer, readBuffer);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+
+    ASSERT_from_busWriteRead_SIZE(1);
+    ASSERT_from_jobDoneOut(0, 1, Drv::I2cStatus::I2C_ADDRESS_ERR, readBuffer);
+    ASSERT_TLM_jobErrors(0, 1);
+
+    // a write-only job is a plain write
+    this->m_writeStatus = Drv::I2cStatus::I2C_OK;
+    Fw::Buffer emptyBuffer;
+    this->invoke_to_jobIn(0, 2, ADDRESS_TEST, writeBuffer, emptyBuffer);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_from_busWrite_SIZE(1);
+    ASSERT_from_busRead_SIZE(0);
+    ASSERT_from_jobDoneOut(1, 2, Drv::I2cStatus::I2C_OK, emptyBuffer);
+
+    // and a read-only job is a plain read
+    this->invoke_to_jobIn(0, 3, ADDRESS_TEST, emptyBuffer, readBuffer);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_from_busRead_SIZE(1);
+    ASSERT_from_busWriteRead_SIZE(1);
+    ASSERT_from_jobDoneOut(2, 3, Drv::I2cStatus::I2C_OK, readBuffer);
+  }
+
+
+  void I2cBusManagerTester ::
+    testSyncAccess()
+  {
+    U8 data[2] = {0x6B, 0x00};
+    Fw::Buffer buffer(data, sizeof data);
+
+    // configuration traffic runs on the caller's thread without queueing
+    ASSERT_EQ(this->invoke_to_write(0, ADDRESS_TEST, buffer), Drv::I2cStatus::I2C_OK);
+    ASSERT_from_busWrite_SIZE(1);
+
+    this->m_readStatus = Drv::I2cStatus::I2C_READ_ERR;
+    ASSERT_EQ(this->invoke_to_read(0, ADDRESS_TEST, buffer), Drv::I2cStatus::I2C_READ_ERR);
+    ASSERT_from_busRead_SIZE(1);
+
+    U8 pointer = 0x75;
+    U8 whoAmI = 0;
+    Fw::Buffer pointerBuffer(&pointer, sizeof pointer);
+    Fw::Buffer readBuffer(&whoAmI, sizeof whoAmI);
+    this->m_readStatus = Drv::I2cStatus::I2C_OK;
+    ASSERT_EQ(this->invoke_to_writeRead(0, ADDRESS_TEST, pointerBuffer, readBuffer), Drv::I2cStatus::I2C_OK);
+    ASSERT_from_busWriteRead_SIZE(1);
+    ASSERT_EQ(whoAmI, 0xA5);
+
+    ASSERT_from_jobDoneOut_SIZE(0);
+    ASSERT_TLM_SIZE(0);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handlers for typed from ports
+  // ----------------------------------------------------------------------
+
+  Drv::I2cStatus I2cBusManagerTester ::
+    from_busWrite_handler(FwIndexType portNum, U32 addr, Fw::Buffer& serBuffer)
+  {
+    this->pushFromPortEntry_busWrite(addr, serBuffer);
+    return this->m_writeStatus;
+  }
+
+  Drv::I2cStatus I2cBusManagerTester ::
+    from_busRead_handler(FwIndexType portNum, U32 addr, Fw::Buffer& serBuffer)
+  {
+    this->pushFromPortEntry_busRead(addr, serBuffer);
+    if (this->m_readStatus == Drv::I2cStatus::I2C_OK) {
+      memset(serBuffer.getData(), 0xA5, serBuffer.getSize());
+    }
+    return this->m_readStatus;
+  }
+
+  Drv::I2cStatus I2cBusManagerTester ::
+    from_busWriteRead_handler(FwIndexType portNum, U32 addr, Fw::Buffer& writeBuffer, Fw::Buffer& readBuffer)
+  {
+    this->pushFromPortEntry_busWriteRead(addr, writeBuffer, readBuffer);
+    if (this->m_writeStatus != Drv::I2cStatus::I2C_OK) {
+      return this->m_writeStatus;
+    }
+    if (this->m_readStatus == Drv::I2cStatus::I2C_OK) {
+      memset(readBuffer.getData(), 0xA5, readBuffer.getSize());
+    }
+    return this->m_readStatus;
+  }
+
+  void I2cBusManagerTester ::
+    from_jobDoneOut_handler(
+        FwIndexType portNum,
+        U32 context,
+        const Drv::I2cStatus& status,
+        const Fw::Buffer& readBuffer
+    )
+  {
+    this->pushFromPortEntry_jobDoneOut(context, status, readBuffer);
+    if (this->m_doneCount < MAX_HISTORY_SIZE) {
+      this->m_donePorts[this->m_doneCount] = portNum;
+      this->m_doneCount++;
+    }
+  }
+
+}
@@ -0,0 +1,129 @@
+// ======================================================================
+// \title  I2cBusManagerTester.hpp
+// \author aidandb
+// \brief  hpp file for I2cBusManager component test harness implementation class
+// ======================================================================
+
+#ifndef Components_I2cBusManagerTester_HPP
+#define Components_I2cBusManagerTester_HPP
+
+#include "Components/I2cBusManager/I2cBusManagerGTestBase.hpp"
+#include "Components/I2cBusManager/I2cBusManager.hpp"
+
+namespace Components {
+
+  class I2cBusManagerTester :
+    public I2cBusManagerGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object I2cBusManagerTester
+      I2cBusManagerTester();
+
+      //! Destroy object I2cBusManagerTester
+      ~I2cBusManagerTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testWriteThenRead();
+
+      void testJobOrder();
+
+      void testWriteError();
+
+      void testSyncAccess();
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handlers for typed from ports
+      // ----------------------------------------------------------------------
+
+      //! Handler for from_busWrite
+      Drv::I2cStatus from_busWrite_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler for from_busRead
+      Drv::I2cStatus from_busRead_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler for from_busWriteRead
+      Drv::I2cStatus from_busWriteRead_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& writeBuffer, //!< Buffer to write data to the i2c device
+          Fw::Buffer& readBuffer //!< Buffer to read back data from the i2c device
+      ) override;
+
+      //! Handler for from_jobDoneOut
+      void from_jobDoneOut_handler(
+          FwIndexType portNum, //!< The port number
+          U32 context, //!< tag the job was submitted with
+          const Drv::I2cStatus& status, //!< status of the first transaction that failed, or I2C_OK
+          const Fw::Buffer& readBuffer //!< the job's read buffer, filled when status is I2C_OK
+      ) override;
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      I2cBusManager component;
+
+      // status returned by the bus driver
+      Drv::I2cStatus m_writeStatus;
+      Drv::I2cStatus m_readStatus;
+
+      // port each completion came back on, in order
+      FwIndexType m_donePorts[MAX_HISTORY_SIZE];
+      U32 m_doneCount;
+
+  };
+
+}
+
+#endif
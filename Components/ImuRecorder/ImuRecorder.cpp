@@ -0,0 +1,180 @@
+// ======================================================================
+// \title  ImuRecorder.cpp
+// \author aidandb
+// \brief  cpp file for ImuRecorder component implementation class
+// ======================================================================
+
+#include "Components/ImuRecorder/ImuRecorder.hpp"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  ImuRecorder ::
+    ImuRecorder(const char* const compName) :
+      ImuRecorderComponentBase(compName),
+      m_chunksDropped(0)
+  {
+
+  }
+
+  void ImuRecorder ::
+    init(const NATIVE_INT_TYPE queueDepth, const NATIVE_INT_TYPE instance)
+  {
+    ImuRecorderComponentBase::init(queueDepth, instance);
+  }
+
+  void ImuRecorder ::
+    configure(const char* filePrefix, FwSizeType maxFileSize)
+  {
+    FW_ASSERT(filePrefix != nullptr);
+    FW_ASSERT(maxFileSize > 0);
+    this->m_filePrefix = filePrefix;
+    this->m_maxFileSize = maxFileSize;
+  }
+
+  ImuRecorder ::
+    ~ImuRecorder()
+  {
+    if (this->m_file.isOpen()) {
+      this->m_file.close();
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  void ImuRecorder ::
+    chunkIn_handler(
+        FwIndexType portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    bool written = false;
+
+    if (this->m_recording) {
+      // a chunk is never split across files, it starts the next one instead
+      if ((this->m_fileSize > 0) && ((this->m_fileSize + fwBuffer.getSize()) > this->m_maxFileSize)) {
+        closeFile();
+        this->m_fileIndex++;
+        (void) openFile();
+      }
+      if (this->m_recording) {
+        written = writeChunk(fwBuffer);
+      }
+    }
+
+    if (!written) {
+      dropChunk();
+    }
+    this->deallocate_out(0, fwBuffer);
+  }
+
+  void ImuRecorder ::
+    chunkIn_overflowHook(
+        FwIndexType portNum,
+        Fw::Buffer& fwBuffer
+    )
+  {
+    // storage has fallen behind; the sampling thread must not wait for it, so the chunk goes back unwritten
+    dropChunk();
+    this->deallocate_out(0, fwBuffer);
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for commands
+  // ----------------------------------------------------------------------
+
+  void ImuRecorder ::
+    START_RECORDING_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    closeFile();
+
+    // the start time keeps file names from different recordings apart
+    this->m_session = this->getTime().getSeconds();
+    this->m_fileIndex = 0;
+    this->m_recording = true;
+
+    const bool opened = openFile();
+    this->cmdResponse_out(opCode, cmdSeq, opened ? Fw::CmdResponse::OK : Fw::CmdResponse::EXECUTION_ERROR);
+  }
+
+  void ImuRecorder ::
+    STOP_RECORDING_cmdHandler(
+        FwOpcodeType opCode,
+        U32 cmdSeq
+    )
+  {
+    this->m_recording = false;
+    closeFile();
+    this->cmdResponse_out(opCode, cmdSeq, Fw::CmdResponse::OK);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Functions
+  // ----------------------------------------------------------------------
+
+  bool ImuRecorder ::
+    openFile()
+  {
+    FW_ASSERT(this->m_maxFileSize > 0);
+    this->m_fileName.format("%s_%" PRIu32 "_%" PRIu32 ".bin", this->m_filePrefix.toChar(), this->m_session,
+                            this->m_fileIndex);
+    this->m_fileSize = 0;
+
+    const Os::File::Status status = this->m_file.open(this->m_fileName.toChar(), Os::File::OPEN_CREATE);
+    if (status != Os::File::OP_OK) {
+      this->m_recording = false;
+      this->log_WARNING_HI_FileError(this->m_fileName, static_cast<I32>(status));
+      return false;
+    }
+    this->log_ACTIVITY_HI_FileOpened(this->m_fileName);
+    return true;
+  }
+
+  void ImuRecorder ::
+    closeFile()
+  {
+    if (this->m_file.isOpen()) {
+      this->m_file.close();
+      this->log_ACTIVITY_HI_FileClosed(this->m_fileName, this->m_fileSize);
+    }
+  }
+
+  bool ImuRecorder ::
+    writeChunk(const Fw::Buffer& fwBuffer)
+  {
+    const FwSignedSizeType expected = static_cast<FwSignedSizeType>(fwBuffer.getSize());
+    FwSignedSizeType size = expected;
+
+    // chunks arrive whole and fixed size, so every write is one large write at an aligned offset
+    const Os::File::Status status = this->m_file.write(fwBuffer.getData(), size, Os::File::WaitType::WAIT);
+    if ((status != Os::File::OP_OK) || (size != expected)) {
+      this->log_WARNING_HI_FileError(this->m_fileName, static_cast<I32>(status));
+      this->m_recording = false;
+      closeFile();
+      return false;
+    }
+
+    this->m_fileSize += static_cast<U64>(size);
+    this->m_bytesRecorded += static_cast<U64>(size);
+    this->m_chunksRecorded++;
+    this->tlmWrite_bytesRecorded(this->m_bytesRecorded);
+    this->tlmWrite_chunksRecorded(this->m_chunksRecorded);
+    return true;
+  }
+
+  void ImuRecorder ::
+    dropChunk()
+  {
+    const U32 dropped = ++this->m_chunksDropped;
+    this->tlmWrite_chunksDropped(dropped);
+  }
+
+}
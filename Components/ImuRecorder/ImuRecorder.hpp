@@ -0,0 +1,131 @@
+// ======================================================================
+// \title  ImuRecorder.hpp
+// \author aidandb
+// \brief  hpp file for ImuRecorder component implementation class
+// ======================================================================
+
+#ifndef Components_ImuRecorder_HPP
+#define Components_ImuRecorder_HPP
+
+#include <atomic>
+
+#include "Components/ImuRecorder/ImuRecorderComponentAc.hpp"
+#include "Fw/Types/String.hpp"
+#include "Os/File.hpp"
+
+namespace Components {
+
+  class ImuRecorder :
+    public ImuRecorderComponentBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct ImuRecorder object
+      ImuRecorder(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object ImuRecorder
+      void init(
+          const NATIVE_INT_TYPE queueDepth, //!< The queue depth, no more than the chunk buffers so the hook rarely runs
+          const NATIVE_INT_TYPE instance = 0
+      );
+
+      //! Destroy ImuRecorder object
+      ~ImuRecorder();
+
+      /**
+       * \brief set where recordings go
+       * \param filePrefix: path and name prefix, files are named <prefix>_<start seconds>_<index>.bin
+       * \param maxFileSize: a chunk that would take a file past this size starts the next file
+       */
+      void configure(const char* filePrefix, FwSizeType maxFileSize);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for chunkIn
+      //!
+      //! Port for receiving filled chunks, a full queue hands the chunk straight back
+      void chunkIn_handler(
+          FwIndexType portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+      //! Overflow hook implementation for chunkIn, runs on the sender's thread
+      void chunkIn_overflowHook(
+          FwIndexType portNum, //!< The port number
+          Fw::Buffer& fwBuffer //!< The buffer
+      ) override;
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for commands
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for command START_RECORDING
+      //!
+      //! Command to start a new recording, any open file is closed first
+      void START_RECORDING_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      //! Handler implementation for command STOP_RECORDING
+      //!
+      //! Command to stop recording and close the file so it can be sent with fileDownlink
+      void STOP_RECORDING_cmdHandler(
+          FwOpcodeType opCode, //!< The opcode
+          U32 cmdSeq //!< The command sequence number
+      ) override;
+
+      // ----------------------------------------------------------------------
+      // Helper Functions
+      // ----------------------------------------------------------------------
+
+      /**
+       * \brief open the next file of the recording, stopping the recording if it cannot be opened
+       */
+      bool openFile();
+
+      void closeFile();
+
+      /**
+       * \brief append one chunk as a single write, stopping the recording if the write fails
+       */
+      bool writeChunk(const Fw::Buffer& fwBuffer);
+
+      void dropChunk();
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+      Fw::String m_filePrefix;
+      FwSizeType m_maxFileSize = 0;
+
+      bool m_recording = false;
+      U32 m_session = 0;
+      U32 m_fileIndex = 0;
+      Os::File m_file;
+      Fw::String m_fileName;
+      U64 m_fileSize = 0;
+
+      U64 m_bytesRecorded = 0;
+      U32 m_chunksRecorded = 0;
+
+      // also counted by the overflow hook on the sender's thread
+      std::atomic<U32> m_chunksDropped;
+  };
+
+}
+
+#endif
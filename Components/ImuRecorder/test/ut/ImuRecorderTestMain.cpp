@@ -0,0 +1,32 @@
+// ======================================================================
+// \title  ImuRecorderTestMain.cpp
+// \author aidandb
+// \brief  cpp file for ImuRecorder component test main function
+// ======================================================================
+
+#include "ImuRecorderTester.hpp"
+
+TEST(Nominal, recordAndRotate) {
+  Components::ImuRecorderTester tester;
+  tester.testRecordAndRotate();
+}
+
+TEST(Nominal, stopped) {
+  Components::ImuRecorderTester tester;
+  tester.testStopped();
+}
+
+TEST(Error, queueFull) {
+  Components::ImuRecorderTester tester;
+  tester.testQueueFull();
+}
+
+TEST(Error, openError) {
+  Components::ImuRecorderTester tester;
+  tester.testOpenError();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+// ======================================================================
+// \title  ImuRecorderTester.cpp
+// \author aidandb
+// \brief  cpp file for ImuRecorder component test harness implementation class
+// ======================================================================
+
+#include "ImuRecorderTester.hpp"
+
+#include "Os/FileSystem.hpp"
+
+#define FILE_PREFIX "ImuRecorderTest"
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  ImuRecorderTester ::
+    ImuRecorderTester() :
+      ImuRecorderGTestBase("ImuRecorderTester", ImuRecorderTester::MAX_HISTORY_SIZE),
+      component("ImuRecorder")
+  {
+    memset(this->m_chunks, 0, sizeof this->m_chunks);
+    this->initComponents();
+    this->connectPorts();
+    this->component.configure(FILE_PREFIX, CHUNKS_PER_FILE * CHUNK_SIZE);
+    this->setTestTime(Fw::Time(TB_NONE, 1234, 0));
+  }
+
+  ImuRecorderTester ::
+    ~ImuRecorderTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void ImuRecorderTester ::
+    testRecordAndRotate()
+  {
+    this->sendCmd_START_RECORDING(0, 0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_CMD_RESPONSE(0, ImuRecorder::OPCODE_START_RECORDING, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_FileOpened(0, FILE_PREFIX "_1234_0.bin");
+
+    // every chunk is written and handed back, the one that does not fit starts the next file
+    for (U8 i = 0; i <= CHUNKS_PER_FILE; i++) {
+      this->sendChunk(i);
+      ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    }
+    ASSERT_from_deallocate_SIZE(CHUNKS_PER_FILE + 1);
+    for (U32 i = 0; i <= CHUNKS_PER_FILE; i++) {
+      ASSERT_EQ(this->fromPortHistory_deallocate->at(i).fwBuffer.getData(), this->m_chunks[i]);
+    }
+    ASSERT_EVENTS_FileClosed(0, FILE_PREFIX "_1234_0.bin", CHUNKS_PER_FILE * CHUNK_SIZE);
+    ASSERT_EVENTS_FileOpened(1, FILE_PREFIX "_1234_1.bin");
+    ASSERT_TLM_chunksRecorded(CHUNKS_PER_FILE, CHUNKS_PER_FILE + 1);
+    ASSERT_TLM_bytesRecorded(CHUNKS_PER_FILE, (CHUNKS_PER_FILE + 1) * CHUNK_SIZE);
+    ASSERT_TLM_chunksDropped_SIZE(0);
+
+    this->sendCmd_STOP_RECORDING(0, 0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_CMD_RESPONSE(1, ImuRecorder::OPCODE_STOP_RECORDING, 0, Fw::CmdResponse::OK);
+    ASSERT_EVENTS_FileClosed(1, FILE_PREFIX "_1234_1.bin", CHUNK_SIZE);
+
+    this->checkFile(FILE_PREFIX "_1234_0.bin", 0, CHUNKS_PER_FILE);
+    this->checkFile(FILE_PREFIX "_1234_1.bin", CHUNKS_PER_FILE, 1);
+  }
+
+
+  void ImuRecorderTester ::
+    testStopped()
+  {
+    // chunks that arrive with no recording running go straight back
+    this->sendChunk(0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_from_deallocate_SIZE(1);
+    ASSERT_TLM_chunksDropped(0, 1);
+    ASSERT_TLM_chunksRecorded_SIZE(0);
+    ASSERT_EVENTS_FileOpened_SIZE(0);
+  }
+
+
+  void ImuRecorderTester ::
+    testQueueFull()
+  {
+    for (U8 i = 0; i < TEST_INSTANCE_QUEUE_DEPTH; i++) {
+      this->sendChunk(i);
+    }
+    ASSERT_from_deallocate_SIZE(0);
+
+    // the sender gets the chunk back at once instead of waiting on the recorder
+    this->sendChunk(TEST_INSTANCE_QUEUE_DEPTH);
+    ASSERT_from_deallocate_SIZE(1);
+    ASSERT_EQ(this->fromPortHistory_deallocate->at(0).fwBuffer.getData(), this->m_chunks[TEST_INSTANCE_QUEUE_DEPTH]);
+    ASSERT_TLM_chunksDropped(0, 1);
+
+    // everything queued is still returned
+    for (U32 i = 0; i < TEST_INSTANCE_QUEUE_DEPTH; i++) {
+      ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    }
+    ASSERT_from_deallocate_SIZE(TEST_INSTANCE_QUEUE_DEPTH + 1);
+  }
+
+
+  void ImuRecorderTester ::
+    testOpenError()
+  {
+    this->component.configure("no/such/directory/" FILE_PREFIX, CHUNK_SIZE);
+    this->sendCmd_START_RECORDING(0, 0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_CMD_RESPONSE(0, ImuRecorder::OPCODE_START_RECORDING, 0, Fw::CmdResponse::EXECUTION_ERROR);
+    ASSERT_EVENTS_FileError_SIZE(1);
+    ASSERT_EVENTS_FileOpened_SIZE(0);
+
+    this->sendChunk(0);
+    ASSERT_EQ(this->component.doDispatch(), Fw::QueuedComponentBase::MSG_DISPATCH_OK);
+    ASSERT_from_deallocate_SIZE(1);
+    ASSERT_TLM_chunksDropped(0, 1);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void ImuRecorderTester ::
+    sendChunk(U8 pattern)
+  {
+    FW_ASSERT(pattern <= TEST_INSTANCE_QUEUE_DEPTH, pattern);
+    memset(this->m_chunks[pattern], pattern, CHUNK_SIZE);
+    Fw::Buffer buffer(this->m_chunks[pattern], CHUNK_SIZE);
+    this->invoke_to_chunkIn(0, buffer);
+  }
+
+  void ImuRecorderTester ::
+    checkFile(const char* fileName, U8 firstPattern, FwSizeType chunks)
+  {
+    FwSignedSizeType fileSize = 0;
+    ASSERT_EQ(Os::FileSystem::getFileSize(fileName, fileSize), Os::FileSystem::OP_OK);
+    ASSERT_EQ(static_cast<FwSizeType>(fileSize), chunks * CHUNK_SIZE);
+
+    Os::File file;
+    ASSERT_EQ(file.open(fileName, Os::File::OPEN_READ), Os::File::OP_OK);
+    for (FwSizeType i = 0; i < chunks; i++) {
+      U8 data[CHUNK_SIZE];
+      FwSignedSizeType size = CHUNK_SIZE;
+      ASSERT_EQ(file.read(data, size, Os::File::WaitType::WAIT), Os::File::OP_OK);
+      ASSERT_EQ(static_cast<FwSizeType>(size), CHUNK_SIZE);
+      ASSERT_EQ(memcmp(data, this->m_chunks[firstPattern + i], CHUNK_SIZE), 0);
+    }
+    file.close();
+    ASSERT_EQ(Os::FileSystem::removeFile(fileName), Os::FileSystem::OP_OK);
+  }
+
+}
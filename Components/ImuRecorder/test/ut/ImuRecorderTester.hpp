@@ -0,0 +1,100 @@
+// ======================================================================
+// \title  ImuRecorderTester.hpp
+// \author aidandb
+// \brief  hpp file for ImuRecorder component test harness implementation class
+// ======================================================================
+
+#ifndef Components_ImuRecorderTester_HPP
+#define Components_ImuRecorderTester_HPP
+
+#include "Components/ImuRecorder/ImuRecorderGTestBase.hpp"
+#include "Components/ImuRecorder/ImuRecorder.hpp"
+
+namespace Components {
+
+  class ImuRecorderTester :
+    public ImuRecorderGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 20;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+      // Queue depth supplied to the component instance under test
+      static const FwSizeType TEST_INSTANCE_QUEUE_DEPTH = 10;
+
+      // Size of the chunks sent to the recorder
+      static const FwSizeType CHUNK_SIZE = 256;
+
+      // Number of chunks a file holds before the recorder moves to the next one
+      static const FwSizeType CHUNKS_PER_FILE = 3;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object ImuRecorderTester
+      ImuRecorderTester();
+
+      //! Destroy object ImuRecorderTester
+      ~ImuRecorderTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testRecordAndRotate();
+
+      void testStopped();
+
+      void testQueueFull();
+
+      void testOpenError();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Send one chunk filled with a pattern
+      void sendChunk(U8 pattern);
+
+      //! Check a recording file holds the given chunks and remove it
+      void checkFile(const char* fileName, U8 firstPattern, FwSizeType chunks);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      ImuRecorder component;
+
+      // backing store for chunks in flight, indexed by pattern
+      U8 m_chunks[TEST_INSTANCE_QUEUE_DEPTH + 1][CHUNK_SIZE];
+
+  };
+
+}
+
+#endif
@@ -0,0 +1,428 @@
+// ======================================================================
+// \title  SimAccelGyro.cpp
+// \author aidandb
+// \brief  cpp file for SimAccelGyro component implementation class
+// ======================================================================
+
+#include "Components/SimAccelGyro/SimAccelGyro.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace Components {
+
+  namespace {
+    // catching up after a long gap only needs enough samples to fill the FIFO
+    const U64 MAX_CATCHUP_SAMPLES = SimAccelGyro::FIFO_SIZE_BYTES;
+
+    const F64 TWO_PI = 6.283185307179586;
+
+    I16 saturate(F64 value)
+    {
+      if (value > 32767.0) {
+        return 32767;
+      }
+      if (value < -32768.0) {
+        return -32768;
+      }
+      return static_cast<I16>(std::lround(value));
+    }
+
+    void putBigEndian(U8* registers, U8 registerAddress, I16 value)
+    {
+      registers[registerAddress] = static_cast<U8>(static_cast<U16>(value) >> 8);
+      registers[registerAddress + 1] = static_cast<U8>(static_cast<U16>(value) & 0xFF);
+    }
+  }
+
+  // ----------------------------------------------------------------------
+  // Component construction and destruction
+  // ----------------------------------------------------------------------
+
+  SimAccelGyro ::
+    SimAccelGyro(const char* const compName) :
+      SimAccelGyroComponentBase(compName)
+  {
+
+  }
+
+  void SimAccelGyro ::
+    init(const NATIVE_INT_TYPE instance)
+  {
+    SimAccelGyroComponentBase::init(instance);
+  }
+
+  SimAccelGyro ::
+    ~SimAccelGyro()
+  {
+
+  }
+
+  void SimAccelGyro ::
+    setup(U32 transactionLatencyUs, U32 byteTimeNs)
+  {
+    m_transactionLatencyUs = transactionLatencyUs;
+    m_byteTimeNs = byteTimeNs;
+  }
+
+  bool SimAccelGyro ::
+    addDevice(U32 devAddress)
+  {
+    if (m_numDevices >= MAX_DEVICES) {
+      return false;
+    }
+
+    Device& device = m_devices[m_numDevices];
+    device.address = devAddress;
+    resetDevice(device);
+    m_numDevices++;
+    return true;
+  }
+
+  void SimAccelGyro ::
+    setManualClock(U64 startUs)
+  {
+    m_manualClock = true;
+    m_manualTimeUs = startUs;
+  }
+
+  void SimAccelGyro ::
+    advanceClock(U64 microseconds)
+  {
+    m_manualTimeUs += microseconds;
+  }
+
+  // ----------------------------------------------------------------------
+  // Handler implementations for typed input ports
+  // ----------------------------------------------------------------------
+
+  Drv::I2cStatus SimAccelGyro ::
+    write_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& serBuffer
+    )
+  {
+    const U32 size = serBuffer.getSize();
+    busDelay(size + 1);
+
+    Device* device = findDevice(addr);
+    if (device == nullptr) {
+      return Drv::I2cStatus::I2C_ADDRESS_ERR;
+    }
+
+    const U64 now = nowUs();
+    advance(*device, now);
+    writeBytes(*device, serBuffer, now);
+
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  Drv::I2cStatus SimAccelGyro ::
+    read_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& serBuffer
+    )
+  {
+    const U32 size = serBuffer.getSize();
+    busDelay(size + 1);
+
+    Device* device = findDevice(addr);
+    if (device == nullptr) {
+      return Drv::I2cStatus::I2C_ADDRESS_ERR;
+    }
+
+    advance(*device, nowUs());
+    readBytes(*device, serBuffer);
+
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  Drv::I2cStatus SimAccelGyro ::
+    writeRead_handler(
+        FwIndexType portNum,
+        U32 addr,
+        Fw::Buffer& writeBuffer,
+        Fw::Buffer& readBuffer
+    )
+  {
+    // one transaction: the address byte is sent again after the repeated start
+    busDelay(writeBuffer.getSize() + readBuffer.getSize() + 2);
+
+    Device* device = findDevice(addr);
+    if (device == nullptr) {
+      return Drv::I2cStatus::I2C_ADDRESS_ERR;
+    }
+
+    const U64 now = nowUs();
+    advance(*device, now);
+    writeBytes(*device, writeBuffer, now);
+    readBytes(*device, readBuffer);
+
+    return Drv::I2cStatus::I2C_OK;
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper Functions
+  // ----------------------------------------------------------------------
+
+  void SimAccelGyro ::
+    writeBytes(Device& device, const Fw::Buffer& buffer, U64 nowUs)
+  {
+    // first byte sets the register pointer, any following bytes are written with auto-increment
+    const U8* const data = buffer.getData();
+    const U32 size = buffer.getSize();
+    if (size > 0) {
+      device.pointer = data[0] % NUM_REGISTERS;
+    }
+    for (U32 i = 1; i < size; i++) {
+      writeRegister(device, device.pointer, data[i], nowUs);
+      device.pointer = (device.pointer + 1) % NUM_REGISTERS;
+    }
+  }
+
+  void SimAccelGyro ::
+    readBytes(Device& device, Fw::Buffer& buffer)
+  {
+    // FIFO_R_W is the one register that does not auto-increment so bursts drain the FIFO
+    U8* const data = buffer.getData();
+    const U32 size = buffer.getSize();
+    for (U32 i = 0; i < size; i++) {
+      data[i] = readRegister(device, device.pointer);
+      if (device.pointer != FIFO_R_W_ADDR) {
+        device.pointer = (device.pointer + 1) % NUM_REGISTERS;
+      }
+    }
+  }
+
+  SimAccelGyro::Device* SimAccelGyro ::
+    findDevice(U32 devAddress)
+  {
+    for (U8 i = 0; i < m_numDevices; i++) {
+      if (m_devices[i].address == devAddress) {
+        return &m_devices[i];
+      }
+    }
+    return nullptr;
+  }
+
+  void SimAccelGyro ::
+    resetDevice(Device& device)
+  {
+    // every register powers on as 0 except the sleeping PWR_MGMT_1 and WHO_AM_I
+    memset(device.registers, 0, sizeof device.registers);
+    device.registers[PWR_MGMT_1_ADDR] = PWR_MGMT_1_SLEEP;
+    device.registers[WHO_AM_I_ADDR] = WHO_AM_I_VALUE;
+
+    device.fifoHead = 0;
+    device.fifoCount = 0;
+    device.nextSampleUs = 0;
+    device.sampleIndex = 0;
+    device.noiseState = device.address;
+  }
+
+  U32 SimAccelGyro ::
+    samplePeriodUs(const Device& device) const
+  {
+    // DLPF_CFG of 0 or 7 leaves the gyro output at 8 kHz, every other setting filters it to 1 kHz
+    const U8 dlpf = device.registers[CONFIG_ADDR] & 0x07;
+    const U32 gyroRate = ((dlpf == 0) || (dlpf == 7)) ? GYRO_RATE_DLPF_OFF : GYRO_RATE_DLPF_ON;
+    return (1000000 / gyroRate) * (1 + device.registers[SMPLRT_DIV_ADDR]);
+  }
+
+  void SimAccelGyro ::
+    advance(Device& device, U64 nowUs)
+  {
+    if ((device.registers[PWR_MGMT_1_ADDR] & PWR_MGMT_1_SLEEP) != 0) {
+      return;
+    }
+    if (nowUs < device.nextSampleUs) {
+      return;
+    }
+
+    const U32 period = samplePeriodUs(device);
+    U64 due = ((nowUs - device.nextSampleUs) / period) + 1;
+
+    // samples older than a full FIFO would be overwritten anyway
+    if (due > MAX_CATCHUP_SAMPLES) {
+      const U64 skipped = due - MAX_CATCHUP_SAMPLES;
+      device.sampleIndex += skipped;
+      device.nextSampleUs += skipped * period;
+      due = MAX_CATCHUP_SAMPLES;
+    }
+
+    for (U64 i = 0; i < due; i++) {
+      generateSample(device);
+      device.nextSampleUs += period;
+    }
+  }
+
+  void SimAccelGyro ::
+    generateSample(Device& device)
+  {
+    U8* const registers = device.registers;
+    const F64 t = static_cast<F64>(device.sampleIndex) * static_cast<F64>(samplePeriodUs(device)) / 1.0e6;
+    device.sampleIndex++;
+
+    // full scale selects shift the sensitivity down by a factor of two per step
+    const F64 accelLsbPerG = static_cast<F64>(16384 >> ((registers[ACCEL_CONFIG_ADDR] >> 3) & 0x03));
+    const F64 gyroLsbPerDps = 131.072 / static_cast<F64>(1 << ((registers[GYRO_CONFIG_ADDR] >> 3) & 0x03));
+
+    // a few counts of noise from a small LCG so data is repeatable per device
+    F64 noise[6];
+    for (U32 i = 0; i < 6; i++) {
+      device.noiseState = device.noiseState * 1664525u + 1013904223u;
+      noise[i] = static_cast<F64>(static_cast<I32>(device.noiseState >> 29) - 4);
+    }
+
+    // level and at rest apart from a gentle 1 Hz sway and 0.5 Hz rotation
+    const F64 sway = 0.05 * std::sin(TWO_PI * 1.0 * t);
+    const F64 rotation = 10.0 * std::sin(TWO_PI * 0.5 * t);
+
+    putBigEndian(registers, ACCEL_XOUT_H_ADDR + 0, saturate(sway * accelLsbPerG + noise[0]));
+    putBigEndian(registers, ACCEL_XOUT_H_ADDR + 2, saturate(-sway * accelLsbPerG + noise[1]));
+    putBigEndian(registers, ACCEL_XOUT_H_ADDR + 4, saturate(accelLsbPerG + noise[2]));
+    putBigEndian(registers, TEMP_OUT_H_ADDR, saturate((25.0 - 36.53) * 340.0));
+    putBigEndian(registers, GYRO_XOUT_H_ADDR + 0, saturate(rotation * gyroLsbPerDps + noise[3]));
+    putBigEndian(registers, GYRO_XOUT_H_ADDR + 2, saturate(0.5 * rotation * gyroLsbPerDps + noise[4]));
+    putBigEndian(registers, GYRO_XOUT_H_ADDR + 4, saturate(noise[5]));
+    registers[INT_STATUS_ADDR] |= INT_STATUS_DATA_RDY;
+
+    if ((registers[USER_CTRL_ADDR] & USER_CTRL_FIFO_EN) == 0) {
+      return;
+    }
+
+    // the FIFO is filled in register order for every enabled source
+    const U8 fifoEnable = registers[FIFO_EN_ADDR];
+    if ((fifoEnable & FIFO_EN_ACCEL) != 0) {
+      for (U8 i = 0; i < 6; i++) {
+        fifoPush(device, registers[ACCEL_XOUT_H_ADDR + i]);
+      }
+    }
+    if ((fifoEnable & FIFO_EN_TEMP) != 0) {
+      fifoPush(device, registers[TEMP_OUT_H_ADDR]);
+      fifoPush(device, registers[TEMP_OUT_H_ADDR + 1]);
+    }
+    const U8 gyroBits[3] = {FIFO_EN_XG, FIFO_EN_YG, FIFO_EN_ZG};
+    for (U8 axis = 0; axis < 3; axis++) {
+      if ((fifoEnable & gyroBits[axis]) != 0) {
+        fifoPush(device, registers[GYRO_XOUT_H_ADDR + 2 * axis]);
+        fifoPush(device, registers[GYRO_XOUT_H_ADDR + 2 * axis + 1]);
+      }
+    }
+  }
+
+  void SimAccelGyro ::
+    fifoPush(Device& device, U8 value)
+  {
+    // a full FIFO drops its oldest byte, just like the device
+    if (device.fifoCount == FIFO_SIZE_BYTES) {
+      device.fifoHead = (device.fifoHead + 1) % FIFO_SIZE_BYTES;
+      device.fifoCount--;
+      device.registers[INT_STATUS_ADDR] |= INT_STATUS_FIFO_OFLOW;
+    }
+    device.fifo[(device.fifoHead + device.fifoCount) % FIFO_SIZE_BYTES] = value;
+    device.fifoCount++;
+  }
+
+  U8 SimAccelGyro ::
+    readRegister(Device& device, U8 registerAddress)
+  {
+    U8 value = 0;
+
+    switch (registerAddress) {
+      case FIFO_R_W_ADDR:
+        if (device.fifoCount > 0) {
+          value = device.fifo[device.fifoHead];
+          device.fifoHead = (device.fifoHead + 1) % FIFO_SIZE_BYTES;
+          device.fifoCount--;
+        }
+        break;
+      case FIFO_COUNT_H_ADDR:
+        value = static_cast<U8>(device.fifoCount >> 8);
+        break;
+      case FIFO_COUNT_L_ADDR:
+        value = static_cast<U8>(device.fifoCount & 0xFF);
+        break;
+      case INT_STATUS_ADDR:
+        // interrupt status clears on read
+        value = device.registers[INT_STATUS_ADDR];
+        device.registers[INT_STATUS_ADDR] = 0;
+        break;
+      default:
+        value = device.registers[registerAddress];
+        break;
+    }
+    return value;
+  }
+
+  void SimAccelGyro ::
+    writeRegister(Device& device, U8 registerAddress, U8 value, U64 nowUs)
+  {
+    switch (registerAddress) {
+      case PWR_MGMT_1_ADDR:
+        if ((value & PWR_MGMT_1_RESET) != 0) {
+          resetDevice(device);
+        }
+        else {
+          // sampling starts one period after the device wakes
+          if (((device.registers[PWR_MGMT_1_ADDR] & PWR_MGMT_1_SLEEP) != 0) && ((value & PWR_MGMT_1_SLEEP) == 0)) {
+            device.nextSampleUs = nowUs + samplePeriodUs(device);
+          }
+          device.registers[PWR_MGMT_1_ADDR] = value;
+        }
+        break;
+      case USER_CTRL_ADDR:
+        // FIFO_RESET clears itself once the FIFO is emptied, and is ignored while the FIFO is enabled
+        if (((value & USER_CTRL_FIFO_RESET) != 0) && ((value & USER_CTRL_FIFO_EN) == 0)) {
+          device.fifoHead = 0;
+          device.fifoCount = 0;
+        }
+        device.registers[USER_CTRL_ADDR] = value & static_cast<U8>(~USER_CTRL_FIFO_RESET);
+        break;
+      case FIFO_R_W_ADDR:
+        fifoPush(device, value);
+        break;
+      case INT_STATUS_ADDR:
+      case FIFO_COUNT_H_ADDR:
+      case FIFO_COUNT_L_ADDR:
+      case WHO_AM_I_ADDR:
+        // read only
+        break;
+      default:
+        // sensor data registers are read only
+        if ((registerAddress < ACCEL_XOUT_H_ADDR) || (registerAddress > GYRO_XOUT_H_ADDR + 5)) {
+          device.registers[registerAddress] = value;
+        }
+        break;
+    }
+  }
+
+  U64 SimAccelGyro ::
+    nowUs() const
+  {
+    if (m_manualClock) {
+      return m_manualTimeUs;
+    }
+    const auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<U64>(std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch).count());
+  }
+
+  void SimAccelGyro ::
+    busDelay(U32 bytes) const
+  {
+    // the manual clock is only ever moved by the test driving it
+    if (m_manualClock) {
+      return;
+    }
+
+    const U64 delayNs = static_cast<U64>(m_transactionLatencyUs) * 1000 + static_cast<U64>(bytes) * m_byteTimeNs;
+    if (delayNs > 0) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(delayNs));
+    }
+  }
+
+}
@@ -0,0 +1,195 @@
+// ======================================================================
+// \title  SimAccelGyro.hpp
+// \author aidandb
+// \brief  hpp file for SimAccelGyro component implementation class
+// ======================================================================
+
+#ifndef Components_SimAccelGyro_HPP
+#define Components_SimAccelGyro_HPP
+
+#include "Components/SimAccelGyro/SimAccelGyroComponentAc.hpp"
+
+namespace Components {
+
+  class SimAccelGyro :
+    public SimAccelGyroComponentBase
+  {
+
+    public:
+
+    static const U16 NUM_REGISTERS = 128;
+    static const U16 FIFO_SIZE_BYTES = 1024;
+    static const U8 MAX_DEVICES = 2;
+
+    static const U8 SMPLRT_DIV_ADDR = 0x19;
+    static const U8 CONFIG_ADDR = 0x1A;
+    static const U8 GYRO_CONFIG_ADDR = 0x1B;
+    static const U8 ACCEL_CONFIG_ADDR = 0x1C;
+    static const U8 FIFO_EN_ADDR = 0x23;
+    static const U8 INT_STATUS_ADDR = 0x3A;
+    static const U8 ACCEL_XOUT_H_ADDR = 0x3B;
+    static const U8 TEMP_OUT_H_ADDR = 0x41;
+    static const U8 GYRO_XOUT_H_ADDR = 0x43;
+    static const U8 USER_CTRL_ADDR = 0x6A;
+    static const U8 PWR_MGMT_1_ADDR = 0x6B;
+    static const U8 FIFO_COUNT_H_ADDR = 0x72;
+    static const U8 FIFO_COUNT_L_ADDR = 0x73;
+    static const U8 FIFO_R_W_ADDR = 0x74;
+    static const U8 WHO_AM_I_ADDR = 0x75;
+
+    static const U8 WHO_AM_I_VALUE = 0x68;
+    static const U8 PWR_MGMT_1_RESET = 0x80;
+    static const U8 PWR_MGMT_1_SLEEP = 0x40;
+    static const U8 USER_CTRL_FIFO_EN = 0x40;
+    static const U8 USER_CTRL_FIFO_RESET = 0x04;
+    static const U8 FIFO_EN_TEMP = 0x80;
+    static const U8 FIFO_EN_XG = 0x40;
+    static const U8 FIFO_EN_YG = 0x20;
+    static const U8 FIFO_EN_ZG = 0x10;
+    static const U8 FIFO_EN_ACCEL = 0x08;
+    static const U8 INT_STATUS_FIFO_OFLOW = 0x10;
+    static const U8 INT_STATUS_DATA_RDY = 0x01;
+
+    // gyroscope output rate in Hz, SMPLRT_DIV divides it down to the sample rate
+    static const U32 GYRO_RATE_DLPF_OFF = 8000;
+    static const U32 GYRO_RATE_DLPF_ON = 1000;
+
+      // ----------------------------------------------------------------------
+      // Component construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct SimAccelGyro object
+      SimAccelGyro(
+          const char* const compName //!< The component name
+      );
+
+      //! Initialize object SimAccelGyro
+      void init(const NATIVE_INT_TYPE instance = 0);
+
+      //! Destroy SimAccelGyro object
+      ~SimAccelGyro();
+
+      /**
+       * \brief set the simulated bus timing
+       * \param transactionLatencyUs: fixed cost of every read or write transaction
+       * \param byteTimeNs: time on the wire for each byte, including the address byte
+       */
+      void setup(U32 transactionLatencyUs, U32 byteTimeNs);
+
+      /**
+       * \brief attach a simulated device to the bus at its power on defaults
+       * \param devAddress: 7-bit I2C address the device answers to
+       * \return false when the bus is already full
+       */
+      bool addDevice(U32 devAddress);
+
+      /**
+       * \brief drive the simulation from advanceClock instead of the host monotonic clock
+       */
+      void setManualClock(U64 startUs);
+
+      /**
+       * \brief step the manual clock forward
+       */
+      void advanceClock(U64 microseconds);
+
+    PRIVATE:
+
+      // ----------------------------------------------------------------------
+      // Handler implementations for typed input ports
+      // ----------------------------------------------------------------------
+
+      //! Handler implementation for write
+      //!
+      //! Port for writing data to the simulated device
+      Drv::I2cStatus write_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler implementation for read
+      //!
+      //! Port for reading data from the simulated device
+      Drv::I2cStatus read_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& serBuffer //!< Buffer with data to read/write to/from
+      ) override;
+
+      //! Handler implementation for writeRead
+      //!
+      //! Port for a write then repeated start read on the simulated device
+      Drv::I2cStatus writeRead_handler(
+          FwIndexType portNum, //!< The port number
+          U32 addr, //!< I2C slave device address
+          Fw::Buffer& writeBuffer, //!< Buffer to write data to the i2c device
+          Fw::Buffer& readBuffer //!< Buffer to read back data from the i2c device, must set size when passing in read buffer
+      ) override;
+
+    PRIVATE:
+
+      //! State of one simulated MPU-6050
+      struct Device {
+        U32 address;
+        U8 registers[NUM_REGISTERS];
+        U8 pointer;               //!< register pointer, set by the first byte of a write
+        U8 fifo[FIFO_SIZE_BYTES];
+        U16 fifoHead;             //!< index of the oldest queued byte
+        U16 fifoCount;
+        U64 nextSampleUs;         //!< time the next sample is produced
+        U64 sampleIndex;
+        U32 noiseState;
+      };
+
+      // ----------------------------------------------------------------------
+      // Helper Functions
+      // ----------------------------------------------------------------------
+
+      Device* findDevice(U32 devAddress);
+
+      void resetDevice(Device& device);
+
+      /**
+       * \brief produce every sample that came due since the last transaction
+       */
+      void advance(Device& device, U64 nowUs);
+
+      void generateSample(Device& device);
+
+      void fifoPush(Device& device, U8 value);
+
+      U8 readRegister(Device& device, U8 registerAddress);
+
+      /**
+       * \brief set the register pointer from the first byte and write the rest with auto-increment
+       */
+      void writeBytes(Device& device, const Fw::Buffer& buffer, U64 nowUs);
+
+      /**
+       * \brief read from the register pointer with auto-increment
+       */
+      void readBytes(Device& device, Fw::Buffer& buffer);
+
+      void writeRegister(Device& device, U8 registerAddress, U8 value, U64 nowUs);
+
+      U32 samplePeriodUs(const Device& device) const;
+
+      U64 nowUs() const;
+
+      void busDelay(U32 bytes) const;
+
+      // ----------------------------------------------------------------------
+      // Member Variables
+      // ----------------------------------------------------------------------
+      Device m_devices[MAX_DEVICES];
+      U8 m_numDevices = 0;
+      U32 m_transactionLatencyUs = 0;
+      U32 m_byteTimeNs = 0;
+      bool m_manualClock = false;
+      U64 m_manualTimeUs = 0;
+  };
+
+}
+
+#endif
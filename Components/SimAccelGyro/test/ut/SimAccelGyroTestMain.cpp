@@ -0,0 +1,47 @@
+// ======================================================================
+// \title  SimAccelGyroTestMain.cpp
+// \author aidandb
+// \brief  cpp file for SimAccelGyro component test main function
+// ======================================================================
+
+#include "SimAccelGyroTester.hpp"
+
+TEST(Nominal, powerOnDefaults) {
+  Components::SimAccelGyroTester tester;
+  tester.testPowerOnDefaults();
+}
+
+TEST(Nominal, burstWrite) {
+  Components::SimAccelGyroTester tester;
+  tester.testBurstWrite();
+}
+
+TEST(Nominal, writeRead) {
+  Components::SimAccelGyroTester tester;
+  tester.testWriteRead();
+}
+
+TEST(Nominal, sampleRate) {
+  Components::SimAccelGyroTester tester;
+  tester.testSampleRate();
+}
+
+TEST(Nominal, fifoDrain) {
+  Components::SimAccelGyroTester tester;
+  tester.testFifoDrain();
+}
+
+TEST(Error, fifoOverflow) {
+  Components::SimAccelGyroTester tester;
+  tester.testFifoOverflow();
+}
+
+TEST(Error, addressNack) {
+  Components::SimAccelGyroTester tester;
+  tester.testAddressNack();
+}
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,220 @@
+// ======================================================================
+// \title  SimAccelGyroTester.cpp
+// \author aidandb
+// \brief  cpp file for SimAccelGyro component test harness implementation class
+// ======================================================================
+
+#include "SimAccelGyroTester.hpp"
+
+#define INSTANCE 0
+#define ADDRESS_TEST 0x68
+
+namespace Components {
+
+  // ----------------------------------------------------------------------
+  // Construction and destruction
+  // ----------------------------------------------------------------------
+
+  SimAccelGyroTester ::
+    SimAccelGyroTester() :
+      SimAccelGyroGTestBase("SimAccelGyroTester", SimAccelGyroTester::MAX_HISTORY_SIZE),
+      component("SimAccelGyro")
+  {
+    this->initComponents();
+    this->connectPorts();
+    this->component.setup(0, 0);
+    this->component.setManualClock(0);
+    EXPECT_TRUE(this->component.addDevice(ADDRESS_TEST));
+  }
+
+  SimAccelGyroTester ::
+    ~SimAccelGyroTester()
+  {
+
+  }
+
+  // ----------------------------------------------------------------------
+  // Tests
+  // ----------------------------------------------------------------------
+
+  void SimAccelGyroTester ::
+    testPowerOnDefaults()
+  {
+    U8 value = 0;
+
+    this->readRegisters(SimAccelGyro::WHO_AM_I_ADDR, &value, 1);
+    ASSERT_EQ(value, 0x68);
+
+    this->readRegisters(SimAccelGyro::PWR_MGMT_1_ADDR, &value, 1);
+    ASSERT_EQ(value, 0x40);
+
+    // a sleeping device never produces samples
+    this->component.advanceClock(1000000);
+    U8 data[14];
+    this->readRegisters(SimAccelGyro::ACCEL_XOUT_H_ADDR, data, sizeof data);
+    for (U32 i = 0; i < sizeof data; i++) {
+      ASSERT_EQ(data[i], 0);
+    }
+  }
+
+
+  void SimAccelGyroTester ::
+    testBurstWrite()
+  {
+    // SMPLRT_DIV, CONFIG, GYRO_CONFIG and ACCEL_CONFIG are contiguous
+    U8 data[5] = {SimAccelGyro::SMPLRT_DIV_ADDR, 4, 3, 0x08, 0x10};
+    Fw::Buffer buffer(data, sizeof data);
+    ASSERT_EQ(this->invoke_to_write(0, ADDRESS_TEST, buffer), Drv::I2cStatus::I2C_OK);
+
+    U8 readBack[4] = {};
+    this->readRegisters(SimAccelGyro::SMPLRT_DIV_ADDR, readBack, sizeof readBack);
+    for (U32 i = 0; i < sizeof readBack; i++) {
+      ASSERT_EQ(readBack[i], data[i + 1]);
+    }
+  }
+
+
+  void SimAccelGyroTester ::
+    testWriteRead()
+  {
+    // the pointer write and the read happen in one transaction
+    U8 pointer = SimAccelGyro::WHO_AM_I_ADDR;
+    U8 value = 0;
+    Fw::Buffer writeBuffer(&pointer, sizeof pointer);
+    Fw::Buffer readBuffer(&value, sizeof value);
+    ASSERT_EQ(this->invoke_to_writeRead(0, ADDRESS_TEST, writeBuffer, readBuffer), Drv::I2cStatus::I2C_OK);
+    ASSERT_EQ(value, 0x68);
+
+    // FIFO bursts drain the same way as with separate transactions
+    this->startFifo(9);
+    this->component.advanceClock(30000);
+    pointer = SimAccelGyro::FIFO_R_W_ADDR;
+    U8 fifo[3 * 12];
+    Fw::Buffer fifoBuffer(fifo, sizeof fifo);
+    ASSERT_EQ(this->invoke_to_writeRead(0, ADDRESS_TEST, writeBuffer, fifoBuffer), Drv::I2cStatus::I2C_OK);
+    ASSERT_EQ(this->readFifoCount(), 0);
+
+    ASSERT_EQ(this->invoke_to_writeRead(0, ADDRESS_TEST + 1, writeBuffer, readBuffer), Drv::I2cStatus::I2C_ADDRESS_ERR);
+  }
+
+
+  void SimAccelGyroTester ::
+    testSampleRate()
+  {
+    // 1 kHz gyro rate divided by 10 gives a sample every 10 ms
+    this->startFifo(9);
+
+    this->component.advanceClock(95000);
+    ASSERT_EQ(this->readFifoCount(), 9 * 12);
+
+    this->component.advanceClock(5000);
+    ASSERT_EQ(this->readFifoCount(), 10 * 12);
+
+    // resting level reads 1 g on z
+    U8 data[6];
+    this->readRegisters(SimAccelGyro::ACCEL_XOUT_H_ADDR, data, sizeof data);
+    const I16 z = static_cast<I16>((data[4] << 8) | data[5]);
+    ASSERT_NEAR(z, 16384, 8);
+  }
+
+
+  void SimAccelGyroTester ::
+    testFifoDrain()
+  {
+    this->startFifo(9);
+    this->component.advanceClock(50000);
+    ASSERT_EQ(this->readFifoCount(), 5 * 12);
+
+    // FIFO_R_W does not auto-increment so one burst drains every frame
+    U8 fifo[5 * 12];
+    this->readRegisters(SimAccelGyro::FIFO_R_W_ADDR, fifo, sizeof fifo);
+    ASSERT_EQ(this->readFifoCount(), 0);
+
+    // newest frame matches the data registers, accel then gyro
+    U8 registers[14];
+    this->readRegisters(SimAccelGyro::ACCEL_XOUT_H_ADDR, registers, sizeof registers);
+    for (U32 i = 0; i < 6; i++) {
+      ASSERT_EQ(fifo[48 + i], registers[i]);
+      ASSERT_EQ(fifo[54 + i], registers[8 + i]);
+    }
+  }
+
+
+  void SimAccelGyroTester ::
+    testFifoOverflow()
+  {
+    // 100 frames of 12 bytes at 1 kHz is more than the FIFO holds
+    this->startFifo(0);
+    const U16 fifoSize = SimAccelGyro::FIFO_SIZE_BYTES;
+    this->component.advanceClock(100000);
+    ASSERT_EQ(this->readFifoCount(), fifoSize);
+
+    U8 status = 0;
+    this->readRegisters(SimAccelGyro::INT_STATUS_ADDR, &status, 1);
+    ASSERT_NE(status & SimAccelGyro::INT_STATUS_FIFO_OFLOW, 0);
+
+    // interrupt status clears on read
+    this->readRegisters(SimAccelGyro::INT_STATUS_ADDR, &status, 1);
+    ASSERT_EQ(status & SimAccelGyro::INT_STATUS_FIFO_OFLOW, 0);
+
+    // FIFO_RESET is ignored while the FIFO is enabled, and empties it once it is not
+    this->writeRegister(SimAccelGyro::USER_CTRL_ADDR, SimAccelGyro::USER_CTRL_FIFO_EN | SimAccelGyro::USER_CTRL_FIFO_RESET);
+    ASSERT_EQ(this->readFifoCount(), fifoSize);
+    this->writeRegister(SimAccelGyro::USER_CTRL_ADDR, 0);
+    this->writeRegister(SimAccelGyro::USER_CTRL_ADDR, SimAccelGyro::USER_CTRL_FIFO_RESET);
+    ASSERT_EQ(this->readFifoCount(), 0);
+  }
+
+
+  void SimAccelGyroTester ::
+    testAddressNack()
+  {
+    U8 data[1] = {SimAccelGyro::WHO_AM_I_ADDR};
+    Fw::Buffer buffer(data, sizeof data);
+    ASSERT_EQ(this->invoke_to_write(0, ADDRESS_TEST + 1, buffer), Drv::I2cStatus::I2C_ADDRESS_ERR);
+    ASSERT_EQ(this->invoke_to_read(0, ADDRESS_TEST + 1, buffer), Drv::I2cStatus::I2C_ADDRESS_ERR);
+  }
+
+  // ----------------------------------------------------------------------
+  // Helper functions
+  // ----------------------------------------------------------------------
+
+  void SimAccelGyroTester ::
+    writeRegister(U8 registerAddress, U8 value)
+  {
+    U8 data[2] = {registerAddress, value};
+    Fw::Buffer buffer(data, sizeof data);
+    ASSERT_EQ(this->invoke_to_write(0, ADDRESS_TEST, buffer), Drv::I2cStatus::I2C_OK);
+  }
+
+  void SimAccelGyroTester ::
+    readRegisters(U8 startRegisterAddress, U8* data, U32 size)
+  {
+    Fw::Buffer pointerBuffer(&startRegisterAddress, sizeof startRegisterAddress);
+    ASSERT_EQ(this->invoke_to_write(0, ADDRESS_TEST, pointerBuffer), Drv::I2cStatus::I2C_OK);
+
+    Fw::Buffer buffer(data, size);
+    ASSERT_EQ(this->invoke_to_read(0, ADDRESS_TEST, buffer), Drv::I2cStatus::I2C_OK);
+  }
+
+  U16 SimAccelGyroTester ::
+    readFifoCount()
+  {
+    U8 data[2] = {};
+    this->readRegisters(SimAccelGyro::FIFO_COUNT_H_ADDR, data, sizeof data);
+    return static_cast<U16>((data[0] << 8) | data[1]);
+  }
+
+  void SimAccelGyroTester ::
+    startFifo(U8 sampleRateDivider)
+  {
+    this->writeRegister(SimAccelGyro::SMPLRT_DIV_ADDR, sampleRateDivider);
+    this->writeRegister(SimAccelGyro::CONFIG_ADDR, 1);
+    this->writeRegister(SimAccelGyro::FIFO_EN_ADDR, SimAccelGyro::FIFO_EN_ACCEL | SimAccelGyro::FIFO_EN_XG |
+                                                    SimAccelGyro::FIFO_EN_YG | SimAccelGyro::FIFO_EN_ZG);
+    this->writeRegister(SimAccelGyro::USER_CTRL_ADDR, SimAccelGyro::USER_CTRL_FIFO_RESET);
+    this->writeRegister(SimAccelGyro::USER_CTRL_ADDR, SimAccelGyro::USER_CTRL_FIFO_EN);
+    this->writeRegister(SimAccelGyro::PWR_MGMT_1_ADDR, 0);
+  }
+
+}
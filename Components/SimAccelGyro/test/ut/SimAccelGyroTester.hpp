@@ -0,0 +1,100 @@
+// ======================================================================
+// \title  SimAccelGyroTester.hpp
+// \author aidandb
+// \brief  hpp file for SimAccelGyro component test harness implementation class
+// ======================================================================
+
+#ifndef Components_SimAccelGyroTester_HPP
+#define Components_SimAccelGyroTester_HPP
+
+#include "Components/SimAccelGyro/SimAccelGyroGTestBase.hpp"
+#include "Components/SimAccelGyro/SimAccelGyro.hpp"
+
+namespace Components {
+
+  class SimAccelGyroTester :
+    public SimAccelGyroGTestBase
+  {
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Constants
+      // ----------------------------------------------------------------------
+
+      // Maximum size of histories storing events, telemetry, and port outputs
+      static const FwSizeType MAX_HISTORY_SIZE = 10;
+
+      // Instance ID supplied to the component instance under test
+      static const FwEnumStoreType TEST_INSTANCE_ID = 0;
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Construction and destruction
+      // ----------------------------------------------------------------------
+
+      //! Construct object SimAccelGyroTester
+      SimAccelGyroTester();
+
+      //! Destroy object SimAccelGyroTester
+      ~SimAccelGyroTester();
+
+    public:
+
+      // ----------------------------------------------------------------------
+      // Tests
+      // ----------------------------------------------------------------------
+
+      void testPowerOnDefaults();
+
+      void testBurstWrite();
+
+      void testWriteRead();
+
+      void testSampleRate();
+
+      void testFifoDrain();
+
+      void testFifoOverflow();
+
+      void testAddressNack();
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Helper functions
+      // ----------------------------------------------------------------------
+
+      //! Connect ports
+      void connectPorts();
+
+      //! Initialize components
+      void initComponents();
+
+      //! Write one register on the simulated device
+      void writeRegister(U8 registerAddress, U8 value);
+
+      //! Read a block of registers from the simulated device
+      void readRegisters(U8 startRegisterAddress, U8* data, U32 size);
+
+      //! Read the FIFO byte count
+      U16 readFifoCount();
+
+      //! Wake the device at the given sample rate divider with the FIFO queueing accel and gyro
+      void startFifo(U8 sampleRateDivider);
+
+    private:
+
+      // ----------------------------------------------------------------------
+      // Member variables
+      // ----------------------------------------------------------------------
+
+      //! The component under test
+      SimAccelGyro component;
+
+  };
+
+}
+
+#endif
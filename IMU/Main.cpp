@@ -13,6 +13,8 @@
 #include <getopt.h>
 // Used for printf functions
 #include <cstdlib>
+// Used to check the acquisition CPU exists
+#include <unistd.h>
 
 /**
  * \brief print command line help message
@@ -22,19 +24,21 @@
  * @param app: name of application
  */
 void print_usage(const char* app) {
-    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n", app);
+    (void)printf("Usage: ./%s [options]\n-a\thostname/IP address\n-p\tport_number\n-r\tcycle rate in Hz (1 to %u)\n"
+                 "-c\tCPU to pin the cycle and acquisition tasks to\n",
+                 app, static_cast<unsigned int>(IMU::MAX_CYCLE_RATE_HZ));
 }
 
 /**
  * \brief shutdown topology cycling on signal
  *
- * The reference topology allows for a simulated cycling of the rate groups. This simulated cycling needs to be stopped
- * in order for the program to shutdown. This is done via handling signals such that it is performed via Ctrl-C
+ * The rate groups are driven by a cycle loop on the main thread. This cycle needs to be stopped in order for the program
+ * to shutdown. This is done via handling signals such that it is performed via Ctrl-C
  *
  * @param signum
  */
 static void signalHandler(int signum) {
-    IMU::stopSimulatedCycle();
+    IMU::stopCycle();
 }
 
 /**
@@ -51,10 +55,12 @@ int main(int argc, char* argv[]) {
     I32 option = 0;
     CHAR* hostname = nullptr;
     U16 port_number = 0;
+    U32 cycle_rate = 1;
+    Os::Task::ParamType acquisition_cpu = Os::Task::TASK_DEFAULT;
     Os::init();
 
     // Loop while reading the getopt supplied options
-    while ((option = getopt(argc, argv, "hp:a:")) != -1) {
+    while ((option = getopt(argc, argv, "hp:a:r:c:")) != -1) {
         switch (option) {
             // Handle the -a argument for address/hostname
             case 'a':
@@ -64,6 +70,22 @@ int main(int argc, char* argv[]) {
             case 'p':
                 port_number = static_cast<U16>(atoi(optarg));
                 break;
+            // Handle the -r cycle rate argument
+            case 'r':
+                cycle_rate = static_cast<U32>(strtoul(optarg, nullptr, 10));
+                if ((cycle_rate == 0) || (cycle_rate > IMU::MAX_CYCLE_RATE_HZ)) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            // Handle the -c acquisition CPU argument
+            case 'c':
+                acquisition_cpu = static_cast<Os::Task::ParamType>(strtoul(optarg, nullptr, 10));
+                if (acquisition_cpu >= static_cast<Os::Task::ParamType>(sysconf(_SC_NPROCESSORS_ONLN))) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
             // Cascade intended: help output
             case 'h':
             // Cascade intended: help output
@@ -78,6 +100,8 @@ int main(int argc, char* argv[]) {
     IMU::TopologyState inputs;
     inputs.hostname = hostname;
     inputs.port = port_number;
+    inputs.cycleRateHz = cycle_rate;
+    inputs.acquisitionCpu = acquisition_cpu;
 
     // Setup program shutdown via Ctrl-C
     signal(SIGINT, signalHandler);
@@ -86,8 +110,8 @@ int main(int argc, char* argv[]) {
 
     // Setup, cycle, and teardown topology
     IMU::setupTopology(inputs);
-    IMU::startSimulatedCycle(Fw::TimeInterval(1,0));  // Program loop cycling rate groups at 1Hz
+    IMU::startCycle(inputs);  // Program loop cycling rate groups at the requested rate
     IMU::teardownTopology(inputs);
-    (void)printf("Exiting...\n");
+    (void)printf("Exiting, %llu cycle ticks missed\n", static_cast<unsigned long long>(IMU::cycleMissedTicks()));
     return 0;
 }
@@ -5,15 +5,22 @@
 // ======================================================================
 // Provides access to autocoded functions
 #include <IMU/Top/IMUTopologyAc.hpp>
-// Note: Uncomment when using Svc:TlmPacketizer
-//#include <IMU/Top/IMUPacketsAc.hpp>
+// Note: Comment out when using Svc:TlmChan
+#include <IMU/Top/IMUPacketsAc.hpp>
 
 // Necessary project-specified types
 #include <Fw/Types/MallocAllocator.hpp>
 #include <Svc/FramingProtocol/FprimeProtocol.hpp>
 
-// Used for 1Hz synthetic cycling
-#include <Os/Mutex.hpp>
+// Used for the absolute-deadline cycle and real-time setup
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 
 #include <Fw/Logger/Logger.hpp>
 
@@ -31,14 +38,17 @@ Svc::FprimeDeframing deframing;
 
 Svc::ComQueue::QueueConfigurationTable configurationTable;
 
-// The reference topology divides the incoming clock signal (1Hz) into sub-signals: 1Hz, 1/2Hz, and 1/4Hz with 0 offset
-Svc::RateGroupDriver::DividerSet rateGroupDivisorsSet{{{1, 0}, {2, 0}, {4, 0}}};
+// The cycle runs at the acquisition rate. rateGroup1 runs at that rate, rateGroup2 and rateGroup3 are divided down to
+// 1Hz and 1/4Hz in configureTopology, all with 0 offset
+Svc::RateGroupDriver::DividerSet rateGroupDivisorsSet{{{1, 0}, {1, 0}, {4, 0}}};
 
 // Rate groups may supply a context token to each of the attached children whose purpose is set by the project. The
 // reference topology sets each token to zero as these contexts are unused in this project.
 NATIVE_INT_TYPE rateGroup1Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 NATIVE_INT_TYPE rateGroup2Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 NATIVE_INT_TYPE rateGroup3Context[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE accelGyroBusGroupContext[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
+NATIVE_INT_TYPE auxBusGroupContext[Svc::ActiveRateGroup::CONNECTION_COUNT_MAX] = {};
 
 // A number of constants are needed for construction of the topology. These are specified here.
 enum TopologyConstants {
@@ -56,6 +66,11 @@ enum TopologyConstants {
     DEFRAMER_BUFFER_COUNT = 30,
     COM_DRIVER_BUFFER_SIZE = 3000,
     COM_DRIVER_BUFFER_COUNT = 30,
+    // one chunk being filled per IMU plus a full recorder queue, so the queue cannot overflow
+    IMU_RECORD_BUFFER_SIZE = Components::RawRecord::CHUNK_SIZE,
+    IMU_RECORD_BUFFER_COUNT = 3 + 30,
+    IMU_RECORD_MAX_FILE_SIZE = 1024 * Components::RawRecord::CHUNK_SIZE,
+    IMU_BATCH_QUEUE_DEPTH = 500,
     BUFFER_MANAGER_ID = 200
 };
 
@@ -73,6 +88,8 @@ Svc::Health::PingEntry pingEntries[] = {
     {PingEntries::IMU_rateGroup1::WARN, PingEntries::IMU_rateGroup1::FATAL, "rateGroup1"},
     {PingEntries::IMU_rateGroup2::WARN, PingEntries::IMU_rateGroup2::FATAL, "rateGroup2"},
     {PingEntries::IMU_rateGroup3::WARN, PingEntries::IMU_rateGroup3::FATAL, "rateGroup3"},
+    {PingEntries::IMU_accelGyroBusGroup::WARN, PingEntries::IMU_accelGyroBusGroup::FATAL, "accelGyroBusGroup"},
+    {PingEntries::IMU_auxBusGroup::WARN, PingEntries::IMU_auxBusGroup::FATAL, "auxBusGroup"},
 };
 
 /**
@@ -92,6 +109,8 @@ void configureTopology(const TopologyState& state) {
     upBuffMgrBins.bins[1].numBuffers = DEFRAMER_BUFFER_COUNT;
     upBuffMgrBins.bins[2].bufferSize = COM_DRIVER_BUFFER_SIZE;
     upBuffMgrBins.bins[2].numBuffers = COM_DRIVER_BUFFER_COUNT;
+    upBuffMgrBins.bins[3].bufferSize = IMU_RECORD_BUFFER_SIZE;
+    upBuffMgrBins.bins[3].numBuffers = IMU_RECORD_BUFFER_COUNT;
     bufferManager.setup(BUFFER_MANAGER_ID, 0, mallocator, upBuffMgrBins);
 
     // Framer and Deframer components need to be passed a protocol handler
@@ -101,18 +120,26 @@ void configureTopology(const TopologyState& state) {
     // Command sequencer needs to allocate memory to hold contents of command sequences
     cmdSeq.allocateBuffer(0, mallocator, CMD_SEQ_BUFFER_SIZE);
 
-    // Rate group driver needs a divisor list
+    // Rate group driver needs a divisor list, only acquisition follows the cycle rate
+    FW_ASSERT((state.cycleRateHz > 0) && (state.cycleRateHz <= MAX_CYCLE_RATE_HZ), state.cycleRateHz);
+    rateGroupDivisorsSet.dividers[1].divisor = state.cycleRateHz;
+    rateGroupDivisorsSet.dividers[2].divisor = 4 * state.cycleRateHz;
     rateGroupDriver.configure(rateGroupDivisorsSet);
 
     // Rate groups require context arrays.
     rateGroup1.configure(rateGroup1Context, FW_NUM_ARRAY_ELEMENTS(rateGroup1Context));
     rateGroup2.configure(rateGroup2Context, FW_NUM_ARRAY_ELEMENTS(rateGroup2Context));
     rateGroup3.configure(rateGroup3Context, FW_NUM_ARRAY_ELEMENTS(rateGroup3Context));
+    accelGyroBusGroup.configure(accelGyroBusGroupContext, FW_NUM_ARRAY_ELEMENTS(accelGyroBusGroupContext));
+    auxBusGroup.configure(auxBusGroupContext, FW_NUM_ARRAY_ELEMENTS(auxBusGroupContext));
 
     // File downlink requires some project-derived properties.
     fileDownlink.configure(FILE_DOWNLINK_TIMEOUT, FILE_DOWNLINK_COOLDOWN, FILE_DOWNLINK_CYCLE_TIME,
                            FILE_DOWNLINK_FILE_QUEUE_DEPTH);
 
+    // Raw IMU recordings land in the working directory, 4 MiB per file, ready for fileDownlink.SendFile
+    imuRecorder.configure("ImuRecord", IMU_RECORD_MAX_FILE_SIZE);
+
     // Parameter database is configured with a database file name, and that file must be initially read.
     prmDb.configure("PrmDb.dat");
     prmDb.readParamFile();
@@ -120,15 +147,15 @@ void configureTopology(const TopologyState& state) {
     // Health is supplied a set of ping entires.
     health.setPingEntries(pingEntries, FW_NUM_ARRAY_ELEMENTS(pingEntries), HEALTH_WATCHDOG_CODE);
 
-    // Note: Uncomment when using Svc:TlmPacketizer
-    // tlmSend.setPacketList(IMUPacketsPkts, IMUPacketsIgnore, 1);
+    // Note: Comment out when using Svc:TlmChan
+    tlmSend.setPacketList(IMUPacketsPkts, IMUPacketsIgnore, 1);
 
-    // Events (highest-priority)
+    // Events and summary telemetry packets (highest-priority)
     configurationTable.entries[0] = {.depth = 100, .priority = 0};
-    // Telemetry
-    configurationTable.entries[1] = {.depth = 500, .priority = 2};
+    // IMU batch packets, 500 batches hold 5 s of samples from three IMUs at 1 kHz
+    configurationTable.entries[1] = {.depth = IMU_BATCH_QUEUE_DEPTH, .priority = 1};
     // File Downlink
-    configurationTable.entries[2] = {.depth = 100, .priority = 1};
+    configurationTable.entries[2] = {.depth = 100, .priority = 2};
     // Allocation identifier is 0 as the MallocAllocator discards it
     comQueue.configure(configurationTable, 0, mallocator);
     if (state.hostname != nullptr && state.port != 0) {
@@ -137,9 +164,55 @@ void configureTopology(const TopologyState& state) {
     
 }
 
+/**
+ * \brief keep the whole process resident so acquisition never waits on a page fault
+ *
+ * Locks current and future mappings, which also populates every task stack and buffer allocated during setup, stops
+ * malloc from handing memory back to the kernel and touches the main thread stack the cycle runs on. Without the
+ * privilege to lock memory the deployment still runs, with a warning.
+ */
+__attribute__((noinline)) void lockMemory() {
+    (void)mallopt(M_TRIM_THRESHOLD, -1);
+    (void)mallopt(M_MMAP_MAX, 0);
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        Fw::Logger::log("[WARNING] Unable to lock memory: %s\n", strerror(errno));
+    }
+
+    volatile U8 stack[PREFAULT_STACK_SIZE];
+    for (FwSizeType i = 0; i < PREFAULT_STACK_SIZE; i += 1024) {
+        stack[i] = 0;
+    }
+}
+
+/**
+ * \brief run the calling thread as the SCHED_FIFO cycle, pinned to the acquisition CPU when one is given
+ */
+void setCycleScheduling(const TopologyState& state) {
+    sched_param param;
+    memset(&param, 0, sizeof param);
+    param.sched_priority = CYCLE_PRIORITY;
+    int status = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (status != 0) {
+        Fw::Logger::log("[WARNING] Cycle is not real-time: %s\n", strerror(status));
+    }
+
+    if (state.acquisitionCpu != Os::Task::TASK_DEFAULT) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(static_cast<int>(state.acquisitionCpu), &cpus);
+        status = pthread_setaffinity_np(pthread_self(), sizeof cpus, &cpus);
+        if (status != 0) {
+            Fw::Logger::log("[WARNING] Cycle is not pinned to CPU %d: %s\n", static_cast<int>(state.acquisitionCpu),
+                            strerror(status));
+        }
+    }
+}
+
 // Public functions for use in main program are namespaced with deployment name IMU
 namespace IMU {
 void setupTopology(const TopologyState& state) {
+    // Memory is locked before any task or buffer exists so all of them are resident from the start
+    lockMemory();
     // Autocoded initialization. Function provided by autocoder.
     initComponents(state);
     // Autocoded id setup. Function provided by autocoder.
@@ -164,30 +237,73 @@ void setupTopology(const TopologyState& state) {
     }
 }
 
-// Variables used for cycle simulation
-Os::Mutex cycleLock;
-volatile bool cycleFlag = true;
+// Cycle state, cleared from a signal handler so the flag is a lock-free atomic rather than a mutex. Missed ticks are
+// counted by acquisitionDriver, which sends them down as telemetry
+std::atomic<bool> cycleFlag(true);
 
-void startSimulatedCycle(Fw::TimeInterval interval) {
-    cycleLock.lock();
-    bool cycling = cycleFlag;
-    cycleLock.unLock();
+namespace {
+const U64 NS_PER_SECOND = 1000000000;
 
-    // Main loop
-    while (cycling) {
+U64 monotonicNs() {
+    timespec now;
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<U64>(now.tv_sec) * NS_PER_SECOND + static_cast<U64>(now.tv_nsec);
+}
+}  // namespace
+
+void startCycle(const TopologyState& state) {
+    const U32 rateHz = state.cycleRateHz;
+    FW_ASSERT((rateHz > 0) && (rateHz <= MAX_CYCLE_RATE_HZ), rateHz);
+    setCycleScheduling(state);
+
+    // Deadlines are whole seconds plus tick * 1s / rate, so no rounding of the period builds up
+    U64 secondNs = monotonicNs();
+    U32 tick = 1;
+    U64 deadlineNs = secondNs + NS_PER_SECOND / rateHz;
+    U64 reported = 0;
+
+    while (cycleFlag.load(std::memory_order_relaxed)) {
+        // Sleeping to an absolute deadline does not drift with the time spent in the ISR or waking late
+        timespec deadline;
+        deadline.tv_sec = static_cast<time_t>(deadlineNs / NS_PER_SECOND);
+        deadline.tv_nsec = static_cast<long>(deadlineNs % NS_PER_SECOND);
+        if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+            continue;
+        }
         IMU::blockDrv.callIsr();
-        Os::Task::delay(interval);
 
-        cycleLock.lock();
-        cycling = cycleFlag;
-        cycleLock.unLock();
+        // Deadlines already passed are counted as missed and skipped rather than run back to back
+        const U64 nowNs = monotonicNs();
+        U64 missed = 0;
+        do {
+            if (tick == rateHz) {
+                secondNs += NS_PER_SECOND;
+                tick = 0;
+                // New misses are reported at most once a second
+                const U64 total = IMU::acquisitionDriver.missedTicks();
+                if (total != reported) {
+                    Fw::Logger::log("[Cycle] %llu ticks missed, %llu since start\n",
+                                    static_cast<unsigned long long>(total - reported),
+                                    static_cast<unsigned long long>(total));
+                    reported = total;
+                }
+            }
+            tick++;
+            deadlineNs = secondNs + (static_cast<U64>(tick) * NS_PER_SECOND) / rateHz;
+            missed++;
+        } while (deadlineNs <= nowNs);
+        if (missed > 1) {
+            IMU::acquisitionDriver.ticksMissed(missed - 1);
+        }
     }
 }
 
-void stopSimulatedCycle() {
-    cycleLock.lock();
-    cycleFlag = false;
-    cycleLock.unLock();
+void stopCycle() {
+    cycleFlag.store(false, std::memory_order_relaxed);
+}
+
+U64 cycleMissedTicks() {
+    return IMU::acquisitionDriver.missedTicks();
 }
 
 void teardownTopology(const TopologyState& state) {
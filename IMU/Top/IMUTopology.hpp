@@ -60,27 +60,33 @@ void setupTopology(const TopologyState& state);
 void teardownTopology(const TopologyState& state);
 
 /**
- * \brief cycle the rate group driver at a crude rate
+ * \brief cycle the rate group driver from an absolute-deadline clock
  *
- * The reference topology does not have a true 1Hz input clock for the rate group driver because it is designed to
- * operate across various computing endpoints (e.g. laptops) where a clear 1Hz source may not be easily and generically
- * achieved. This function mimics the cycling via a Task::delay(milliseconds) loop that manually invokes the ISR call
- * to the example block driver.
+ * Sleeps with clock_nanosleep(TIMER_ABSTIME) on CLOCK_MONOTONIC to each deadline and invokes the ISR call to the block
+ * driver. Deadlines are computed from the start time rather than from the last wake up, so the cycle does not drift
+ * however late each wake up is. A deadline that has already passed when the last tick returns is skipped and counted
+ * as missed, and new misses are printed at most once a second.
  *
- * This loop is stopped via a startSimulatedCycle call.
+ * The calling thread becomes the SCHED_FIFO cycle at CYCLE_PRIORITY, pinned to the acquisition CPU when one is given.
+ * Without the privilege for either the cycle still runs, with a warning.
  *
- * Note: projects should replace this with a component that produces an output port call at the appropriate frequency.
+ * This loop is stopped via a stopCycle call.
  *
- * \param milliseconds: milliseconds to delay for each cycle. Default: 1000 or 1Hz.
+ * \param state: state object provided to setupTopology, cycleRateHz is 1 to MAX_CYCLE_RATE_HZ ticks per second
  */
-void startSimulatedCycle(Fw::TimeInterval interval = Fw::TimeInterval(1,0));
+void startCycle(const TopologyState& state);
 
 /**
- * \brief stop the simulated cycle started by startSimulatedCycle
+ * \brief stop the cycle started by startCycle
  *
- * This stops the cycle started by startSimulatedCycle.
+ * Clears an atomic flag so it is safe to call from a signal handler. The cycle stops after its current sleep.
  */
-void stopSimulatedCycle();
+void stopCycle();
+
+/**
+ * \brief number of ticks the cycle has skipped because they were already late
+ */
+U64 cycleMissedTicks();
 
 } // namespace IMU
 #endif
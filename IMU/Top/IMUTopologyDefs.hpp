@@ -9,6 +9,7 @@
 #include "Drv/BlockDriver/BlockDriver.hpp"
 #include "Fw/Types/MallocAllocator.hpp"
 #include "IMU/Top/FppConstantsAc.hpp"
+#include "Os/Task.hpp"
 #include "Svc/FramingProtocol/FprimeProtocol.hpp"
 #include "Svc/Health/Health.hpp"
 
@@ -25,8 +26,19 @@ namespace IMU {
 struct TopologyState {
     const CHAR* hostname;
     U16 port;
+    U32 cycleRateHz;  //!< rate of the cycle driving rateGroupDriver, acquisition runs at this rate
+    Os::Task::ParamType acquisitionCpu;  //!< CPU the cycle and acquisition tasks are pinned to, or TASK_DEFAULT
 };
 
+//! Fastest cycle accepted, the MPU-6050 gyro output rate with the DLPF off
+const U32 MAX_CYCLE_RATE_HZ = 8000;
+
+//! SCHED_FIFO priority of the cycle thread, above the acquisition tasks it wakes
+const int CYCLE_PRIORITY = Acquisition::PRIORITY + 5;
+
+//! Main thread stack touched at startup so the cycle never takes a page fault growing it
+const FwSizeType PREFAULT_STACK_SIZE = 256 * 1024;
+
 /**
  * \brief required ping constants
  *
@@ -83,6 +95,12 @@ enum { WARN = 3, FATAL = 5 };
 namespace IMU_rateGroup3 {
 enum { WARN = 3, FATAL = 5 };
 }
+namespace IMU_accelGyroBusGroup {
+enum { WARN = 3, FATAL = 5 };
+}
+namespace IMU_auxBusGroup {
+enum { WARN = 3, FATAL = 5 };
+}
 }  // namespace PingEntries
 }  // namespace IMU
 #endif
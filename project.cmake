@@ -1,5 +1,13 @@
 # This CMake file is intended to register project-wide objects.
 # This allows for reuse between deployments, or other projects.
 
+# Per-stage latency histograms in AccelGyro; set project wide as it changes the component's layout
+option(ACCELGYRO_STAGE_PROFILING "Time each stage of the AccelGyro acquisition path" ON)
+if (ACCELGYRO_STAGE_PROFILING)
+  add_compile_definitions(ACCELGYRO_STAGE_PROFILING=1)
+else()
+  add_compile_definitions(ACCELGYRO_STAGE_PROFILING=0)
+endif()
+
 add_fprime_subdirectory("${CMAKE_CURRENT_LIST_DIR}/Components")
 add_fprime_subdirectory("${CMAKE_CURRENT_LIST_DIR}/IMU/")